@@ -58,6 +58,30 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
 #define LCD_COLS     16  ///< Number of characters per row
 #define LCD_ROWS     2   ///< Number of rows
 
+/**
+ * @brief LCD bus backend (see hardware/lcd_bus.h)
+ * @details BATCHED queues the PCF8574 states of a whole update, enable
+ *          strobes included, and sends them as one I2C transaction;
+ *          LIBRARY sends every expander write through LiquidCrystal_I2C
+ */
+#define LCD_BACKEND_LIBRARY 0
+#define LCD_BACKEND_BATCHED 1
+#ifndef LCD_BACKEND
+  #define LCD_BACKEND LCD_BACKEND_BATCHED
+#endif
+
+/**
+ * @brief LCD pages (see tasks/lcd_pages.h)
+ * @details SENSOR, TREND (sparklines), ML and NET pages, advanced by the
+ *          rotation timer, the page button or POST /lcd/page
+ */
+#ifndef LCD_PAGE_ROTATE_MS
+  #define LCD_PAGE_ROTATE_MS  5000    ///< Auto-advance period, 0 = button / web only
+#endif
+#define LCD_PAGE_BUTTON_PIN   0       ///< Active-low page button (BOOT), -1 = none
+#define LCD_PAGE_DEBOUNCE_MS  200
+#define LCD_SPARK_PERIOD_MS   15000   ///< Readings averaged into one sparkline column
+
 /* ====== NeoPixel Configuration ====== */
 
 /**
@@ -81,7 +105,59 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
  *          - BLINK mode: Synchronized flashing
  */
 #define NEOPIXEL_UI_PIN 6    ///< GPIO pin for UI bar
-#define NEOPIXEL_UI_NUM 4    ///< Number of pixels in strip
+#ifndef NEOPIXEL_UI_NUM
+  #define NEOPIXEL_UI_NUM 4  ///< Number of pixels in strip
+#endif
+
+/**
+ * @brief DEMO rainbow speed and spread (8.8 fixed-point hue, 256 = full turn)
+ * @details 209 ≈ 0.02 rad per step of the original float animation:
+ *          the hue advances 12 steps per frame and 40 steps per pixel
+ */
+#define NEO_DEMO_STEP     (12 * 209)  ///< Hue advance per frame
+#define NEO_DEMO_SPACING  (40 * 209)  ///< Hue offset between neighbouring pixels
+
+/**
+ * @brief UI keyframe patterns (SOS, BLINK, uploaded; see neo_pattern.h)
+ * @details SOS uses Morse timing: dot 1 unit, dash 3, gaps 1 / 3 (letter) /
+ *          7 (word). The UI task sleeps until the next keyframe, but at
+ *          most NEO_PATTERN_MAX_SLEEP_MS so the task watchdog stays fed
+ */
+#define NEO_SOS_UNIT_MS           150   ///< Morse unit (one SOS = 34 units)
+#define NEO_BLINK_HALF_MS         360   ///< BLINK on / off time
+#define NEO_PATTERN_MAX_KEYS      32    ///< Keyframes of an uploaded pattern
+#define NEO_PATTERN_MAX_SLEEP_MS  1000  ///< Longest UI task sleep
+
+/**
+ * @brief NeoPixel output driver (see neo_compositor.h)
+ * @details RMT: frames are encoded into RMT symbols and sent in the
+ *          background, completion is signaled by the TX-end interrupt.
+ *          ADAFRUIT: Adafruit_NeoPixel::show(), which returns once the
+ *          frame is on the wire.
+ * @note The RMT driver needs the legacy IDF 4.x RMT API (Arduino core 2.x);
+ *       with IDF 5 the compositor falls back to ADAFRUIT
+ */
+#define NEO_DRIVER_ADAFRUIT 0
+#define NEO_DRIVER_RMT      1
+#ifndef NEO_DRIVER
+  #define NEO_DRIVER NEO_DRIVER_RMT
+#endif
+#define NEO_RMT_CH_HUM 2      ///< RMT TX channel of the humidity pixel
+#define NEO_RMT_CH_UI  3      ///< RMT TX channel of the UI bar
+
+/**
+ * @brief NeoPixel output stage: gamma and global brightness
+ * @details Every channel goes through one 256-entry table,
+ *          gamma(v) * (brightness + 1) / 256, built at compile time (gamma)
+ *          and on brightness changes. The brightness follows a day/night
+ *          schedule once the clock is set (POST /brightness?epoch=...)
+ */
+#define NEO_GAMMA                 2.6
+#define NEO_BRIGHTNESS_DAY        255        ///< 0-255
+#define NEO_BRIGHTNESS_NIGHT      48         ///< 0-255, ~20% current
+#define NEO_NIGHT_START_MIN       (22 * 60)  ///< Local minute of day
+#define NEO_NIGHT_END_MIN         (7 * 60)
+#define NEO_SCHEDULE_CHECK_MS     1000       ///< Schedule evaluation period
 
 /**
  * @brief CPU core assignment for FreeRTOS tasks
@@ -135,6 +211,30 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
 #define DEFAULT_H_COMF_MAX   60.0f  ///< Upper limit of COMFORT range
 #define DEFAULT_H_HUMID_MAX  80.0f  ///< Upper limit of HUMID range (above = WET)
 
+/* ====== Persistent Configuration ====== */
+
+/**
+ * @brief NVS layout version of the stored configuration
+ * @details Bump when SysConfig changes; an older blob is then ignored and
+ *          the defaults above are used until the next save
+ */
+#ifndef CONFIG_SCHEMA_VERSION
+  #define CONFIG_SCHEMA_VERSION 1
+#endif
+
+/**
+ * @brief Save coalescing (flash wear)
+ * @details A change is written to NVS after CONFIG_SAVE_DELAY_MS without
+ *          further changes, at the latest CONFIG_SAVE_MAX_DELAY_MS after
+ *          the first unsaved change
+ */
+#ifndef CONFIG_SAVE_DELAY_MS
+  #define CONFIG_SAVE_DELAY_MS     5000
+#endif
+#ifndef CONFIG_SAVE_MAX_DELAY_MS
+  #define CONFIG_SAVE_MAX_DELAY_MS 60000
+#endif
+
 /* ====== Task Configuration ====== */
 
 /**
@@ -148,8 +248,14 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
 #define TASK_LED_STACK_SIZE     3072  ///< LED control task (simple GPIO operations)
 #define TASK_NEO_HUM_STACK_SIZE 3072  ///< NeoPixel humidity indicator (color calculations)
 #define TASK_NEO_UI_STACK_SIZE  3072  ///< NeoPixel UI bar (animations require buffer)
+#define TASK_LEDS_STACK_SIZE    3072  ///< LED service (both strips, LED_SERVICE=1)
 #define TASK_LCD_STACK_SIZE     3072  ///< LCD display task (text buffer)
 #define TASK_TINYML_STACK_SIZE  8192  ///< TinyML task (ML inference needs large stack)
+#define TASK_WEB_STACK_SIZE     6144  ///< HTTP server task (only with a split/packed placement profile)
+#define TASK_MON_STACK_SIZE     3072  ///< Task monitor (uxTaskGetSystemState sampling)
+#define TASK_EXEC_STACK_SIZE    4096  ///< Cooperative executor (deepest job: DHT20 I2C read)
+#define TASK_LOG_STACK_SIZE     3072  ///< Deferred logger (line buffer + snprintf)
+#define TASK_PWR_STACK_SIZE     3072  ///< Power report (task monitor snapshot)
 
 /**
  * @brief FreeRTOS task priorities (0 = lowest, higher number = higher priority)
@@ -165,6 +271,132 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
 #define TASK_NEO_PRIORITY       2  ///< High - visual indicators
 #define TASK_LCD_PRIORITY       1  ///< Low - display updates less critical
 #define TASK_TINYML_PRIORITY    1  ///< Low - inference can be delayed
+#define TASK_WEB_PRIORITY       1  ///< Same as the Arduino loop task it replaces
+#define TASK_MON_PRIORITY       1  ///< Low - telemetry only
+#define TASK_EXEC_PRIORITY      TASK_DHT_PRIORITY  ///< Executor hosts the sensor job
+#define TASK_LOG_PRIORITY       0  ///< Lowest - prints only when the cores are otherwise idle
+#define TASK_PWR_PRIORITY       1  ///< Low - report only
+
+/**
+ * @brief Task placement profiles (which core each task group runs on)
+ * @details Groups:
+ *          - Sensing: DHT20, LED, NeoPixel and LCD tasks
+ *          - Network: HTTP server (WiFi/lwIP tasks always run on core 0)
+ *          - Compute: TinyML inference
+ *
+ *          PLACEMENT_FLOAT  - every task tskNO_AFFINITY, HTTP served from loop()
+ *                             (original behavior)
+ *          PLACEMENT_SPLIT  - sensing on core 1, network + compute on core 0
+ *                             next to the WiFi stack
+ *          PLACEMENT_PACKED - every task on core 1 (single-core reference)
+ *
+ * @note Select with -D TASK_PLACEMENT_PROFILE=PLACEMENT_SPLIT
+ */
+#define PLACEMENT_FLOAT   0
+#define PLACEMENT_SPLIT   1
+#define PLACEMENT_PACKED  2
+
+#ifndef TASK_PLACEMENT_PROFILE
+  #define TASK_PLACEMENT_PROFILE PLACEMENT_FLOAT
+#endif
+
+#if TASK_PLACEMENT_PROFILE == PLACEMENT_SPLIT
+  #define CORE_SENSING  1
+  #define CORE_NETWORK  0
+  #define CORE_COMPUTE  0
+#elif TASK_PLACEMENT_PROFILE == PLACEMENT_PACKED
+  #define CORE_SENSING  1
+  #define CORE_NETWORK  1
+  #define CORE_COMPUTE  1
+#else
+  #define CORE_SENSING  tskNO_AFFINITY
+  #define CORE_NETWORK  tskNO_AFFINITY
+  #define CORE_COMPUTE  tskNO_AFFINITY
+#endif
+
+/**
+ * @brief Serve HTTP from a dedicated WEB task instead of loop()
+ * @details loop() is pinned to ARDUINO_RUNNING_CORE, so the web server can
+ *          only follow a placement profile when it has its own task
+ */
+#define TASK_WEB_IN_TASK (TASK_PLACEMENT_PROFILE != PLACEMENT_FLOAT)
+
+/**
+ * @brief Allocate every FreeRTOS object the firmware owns statically
+ * @details 1 = task stacks/TCBs (xTaskCreateStaticPinnedToCore) and
+ *          semaphores/mutexes (xSemaphoreCreate*Static) are placed in .bss,
+ *          so their RAM is fixed at link time and reported by
+ *          tools/memory_map.py; the heap then only serves WiFi, WebServer
+ *          and library buffers
+ */
+#ifndef STATIC_ALLOCATION
+  #define STATIC_ALLOCATION 0
+#endif
+
+/**
+ * @brief Run DHT20, LED, NeoPixel and LCD as jobs of one cooperative task
+ * @details 0 = one FreeRTOS task per job, woken by binary semaphores
+ *          (original design); 1 = a single EXEC task runs every job's step
+ *          function to completion, driven by an event queue and a deadline
+ *          scan (see tasks/executor.h). TinyML, HTTP and the task monitor
+ *          stay separate tasks in both modes.
+ */
+#ifndef EXECUTOR_MODE
+  #define EXECUTOR_MODE 0
+#endif
+
+#define EXEC_QUEUE_LEN          8     ///< Pending events (one per producer edge is enough)
+
+/**
+ * @brief Generate the temperature LED blink with a one-shot esp_timer chain
+ * @details 1 = each blink edge is toggled by an esp_timer callback armed on
+ *          absolute times, and the LED task wakes only when the band
+ *          changes; 0 = the LED task wakes on every blink edge and polls
+ *          every 100 ms in CRITICAL (original design)
+ */
+#ifndef LED_BLINK_HW
+  #define LED_BLINK_HW 1
+#endif
+
+/**
+ * @brief Drive both NeoPixel strips from one LED service task
+ * @details 1 = a single LEDS task renders the humidity pixel and the UI
+ *          bar (see tasks/led_service.h); 0 = separate NEO_H and NEO_UI
+ *          tasks (original design). In EXECUTOR_MODE the service is one
+ *          job instead of two.
+ */
+#ifndef LED_SERVICE
+  #define LED_SERVICE 1
+#endif
+
+/* ====== Power Management ====== */
+
+/**
+ * @brief Dynamic frequency scaling + automatic light sleep (see tasks/power_manager.h)
+ * @details Needs CONFIG_PM_ENABLE in the framework build; light sleep also
+ *          needs CONFIG_FREERTOS_USE_TICKLESS_IDLE and is blocked by the
+ *          WiFi driver while the softAP is up. PM locks are held only
+ *          around I2C, NeoPixel and HTTP work.
+ */
+#ifndef POWER_MGMT_ENABLED
+  #define POWER_MGMT_ENABLED 0
+#endif
+
+#define PM_MAX_FREQ_MHZ      240    ///< CPU frequency while a CPU-max lock is held
+#define PM_MIN_FREQ_MHZ      80     ///< Lowest frequency that keeps APB (I2C timing) at 80 MHz
+#define PM_LIGHT_SLEEP       1      ///< Light-sleep when every task is blocked
+#define PM_REPORT_MS         10000  ///< Report window (matches the task monitor's 10 s CPU window)
+#define PM_JITTER_BOUND_US   2000   ///< Allowed DHT20 period jitter (peak-to-peak): 2 ticks
+
+/**
+ * @brief Current model for the estimate (ESP32-S3 datasheet typicals, whole chip)
+ * @note Replace with figures measured on the actual board
+ */
+#define PM_CURRENT_MAX_MA    45.0f  ///< Running at PM_MAX_FREQ_MHZ, radio off
+#define PM_CURRENT_MIN_MA    22.0f  ///< Running at PM_MIN_FREQ_MHZ, radio off
+#define PM_CURRENT_IDLE_MA   13.0f  ///< Idle (WFI) at PM_MIN_FREQ_MHZ
+#define PM_CURRENT_SLEEP_MA  0.3f   ///< Light sleep
+#define PM_CURRENT_WIFI_MA   80.0f  ///< Added while the softAP is up
 
 /* ====== Timing ====== */
 
@@ -181,6 +413,16 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
  */
 #define UI_STRIP_UPDATE_MS      120  ///< ~8 fps for UI animations
 
+/**
+ * @brief Delay between WebServer::handleClient() polls (loop() or WEB task)
+ * @note With power management every poll is a wake-up, so it polls slower
+ */
+#if POWER_MGMT_ENABLED
+  #define HTTP_POLL_MS          20
+#else
+  #define HTTP_POLL_MS          2
+#endif
+
 /**
  * @brief Web server state polling interval (unused in current implementation)
  */
@@ -192,6 +434,281 @@ static const int SCL_PIN = 12;  ///< I2C Serial Clock Line
  */
 #define TINYML_WAIT_FOR_DATA_MS 500   ///< Wait time when sensor data unavailable
 #define TINYML_RETRY_DELAY_MS   1000  ///< Delay after inference failure
-#define TINYML_INFERENCE_MS     5000  ///< Normal interval between inferences (5 seconds)
+#ifndef TINYML_INFERENCE_MS
+  #define TINYML_INFERENCE_MS   5000  ///< Normal interval between inferences (5 seconds)
+#endif
+
+/* ====== TinyML Options ====== */
+
+/**
+ * @brief Evaluate the anomaly model with the hand-specialized kernel
+ * @details 0 = TensorFlow Lite Micro interpreter (default)
+ *          1 = Fixed-size MLP from dht_anomaly_kernel.h (weights extracted
+ *              at build time by tools/gen_anomaly_kernel.py)
+ * @note The interpreter is still initialized and used as golden reference
+ */
+#ifndef TINYML_FAST_KERNEL
+  #define TINYML_FAST_KERNEL 0
+#endif
+
+/**
+ * @brief Verify and benchmark the kernel against TFLM at TinyML task start
+ * @details Runs TINYML_KERNEL_BENCH_SAMPLES inputs through both paths,
+ *          reports max error and invocations/sec on the serial console
+ * @note Enabled by the [env:bench_kernel] PlatformIO environment
+ */
+#ifndef TINYML_KERNEL_BENCH
+  #define TINYML_KERNEL_BENCH 0
+#endif
+
+#define TINYML_KERNEL_BENCH_SAMPLES 4096   ///< Inputs compared per verification run
+#define TINYML_KERNEL_TOLERANCE     1e-4f  ///< Max allowed |kernel - interpreter|
+
+/**
+ * @brief Replay a trace through the model and report latency/throughput
+ * @details See ml/tinyml_bench.h; prints "[BENCH] RESULT: PASS|FAIL" and
+ *          fails when throughput drops more than TINYML_BENCH_MAX_REGRESSION_PCT
+ *          below the baseline
+ * @note Enabled by the [env:bench_tinyml] PlatformIO environment (board only)
+ */
+#ifndef TINYML_BENCH
+  #define TINYML_BENCH 0
+#endif
+
+/**
+ * @brief On-board baselines (inv/s), 0 = report only
+ * @details Recorded explicitly: copy the inv/s of a known-good run into
+ *          -D TINYML_BENCH_BASELINE_IPS / _KERNEL_IPS
+ */
+#ifndef TINYML_BENCH_BASELINE_IPS
+  #define TINYML_BENCH_BASELINE_IPS 0
+#endif
+#ifndef TINYML_BENCH_BASELINE_KERNEL_IPS
+  #define TINYML_BENCH_BASELINE_KERNEL_IPS 0
+#endif
+
+#define TINYML_BENCH_MAX_SAMPLES        2048  ///< Trace samples replayed per run
+#define TINYML_BENCH_PASSES             5     ///< Timed passes per path (best one counts)
+#define TINYML_BENCH_MAX_REGRESSION_PCT 10    ///< Allowed throughput drop vs baseline
+
+/**
+ * @brief Largest model accepted by the /ml/model upload endpoint (bytes)
+ * @details Each of the two model images reserves a RAM buffer of this
+ *          size for a model loaded from LittleFS
+ */
+#define TINYML_MODEL_MAX_BYTES  16384
+
+/**
+ * @brief Tensor arena shared by every model in the pipeline (bytes)
+ * @details Models run one after another, so the arena only has to fit the
+ *          largest of them; the planned requirement is reported at startup
+ *          and by GET /ml/pipeline
+ */
+#ifndef TINYML_ARENA_SIZE
+  #define TINYML_ARENA_SIZE 8192
+#endif
+
+#define TINYML_MAX_OUTPUTS      4     ///< Largest output vector kept per pipeline model
+
+/* ====== Task Monitor ====== */
+
+/**
+ * @brief Per-task CPU share / stack / wake telemetry served by GET /tasks
+ * @details CPU share needs configGENERATE_RUN_TIME_STATS in the FreeRTOS
+ *          build; without it only stack headroom is reported
+ */
+#ifndef TASK_MONITOR_ENABLED
+  #define TASK_MONITOR_ENABLED 1
+#endif
+
+#define TASK_MON_SAMPLE_MS   1000  ///< Sampling period (1 s window resolution)
+#define TASK_MON_MAX_TASKS   24    ///< Tasks tracked (app + IDLE/WiFi/lwIP/loopTask)
+
+/* ====== Placement Benchmark ====== */
+
+/**
+ * @brief Measure sensor-period jitter and HTTP latency under load
+ * @details Spawns one CPU burner per core plus a loopback HTTP client
+ *          (GET /state against the AP address) and prints a report after
+ *          TASK_BENCH_DURATION_MS. Combine with TASK_PLACEMENT_PROFILE to
+ *          compare profiles.
+ * @note Built by the [env:bench_place_*] PlatformIO environments
+ */
+#ifndef TASK_PLACEMENT_BENCH
+  #define TASK_PLACEMENT_BENCH 0
+#endif
+
+#define TASK_BENCH_DURATION_MS      60000  ///< Measurement window
+#define TASK_BENCH_LOAD_BUSY_MS     20     ///< Burner busy time per cycle
+#define TASK_BENCH_LOAD_IDLE_MS     5      ///< Burner sleep per cycle (20/25 = 80% load)
+#define TASK_BENCH_LOAD_PRIORITY    2      ///< Same as LED/NeoPixel, below DHT20
+#define TASK_BENCH_HTTP_PERIOD_MS   50     ///< Delay between loopback requests
+#define TASK_BENCH_HTTP_MAX_SAMPLES 1024   ///< Latency samples kept for percentiles
+
+/* ====== Deadline Monitor ====== */
+
+/**
+ * @brief Period-miss / budget-overrun detection for periodic tasks
+ * @details DHT20, NeoPixel UI and TinyML declare their period (the
+ *          existing *_MS intervals), an execution budget and a lateness
+ *          tolerance; results are served by GET /deadlines
+ */
+#ifndef DEADLINE_MONITOR_ENABLED
+  #define DEADLINE_MONITOR_ENABLED 1
+#endif
+
+/**
+ * @brief What happens after DEADLINE_ESCALATE_AFTER consecutive violations
+ * @details Levels are cumulative:
+ *          DL_ESCALATE_NONE  - count only
+ *          DL_ESCALATE_LOG   - serial log on escalation and recovery
+ *          DL_ESCALATE_ALERT - also raise gLive.deadline_alert
+ *          DL_ESCALATE_WDT   - also stop feeding the task watchdog, so a
+ *                              task escalated for the TWDT timeout trips it
+ */
+#define DL_ESCALATE_NONE   0
+#define DL_ESCALATE_LOG    1
+#define DL_ESCALATE_ALERT  2
+#define DL_ESCALATE_WDT    3
+
+#ifndef DEADLINE_ESCALATION
+  #define DEADLINE_ESCALATION DL_ESCALATE_ALERT
+#endif
+
+#define DEADLINE_ESCALATE_AFTER       3        ///< Consecutive violations before escalating
+#define DEADLINE_DHT_BUDGET_US        100000   ///< DHT20 read() waits ~80 ms for the measurement, + I2C/classify margin
+#define DEADLINE_DHT_TOLERANCE_MS     50       ///< Scheduling delay after the sleep, 10% of DHT_READ_INTERVAL_MS
+#define DEADLINE_NEO_UI_BUDGET_US     5000     ///< One 4-pixel frame
+#define DEADLINE_NEO_UI_TOLERANCE_MS  30       ///< A quarter frame at ~8 fps
+#define DEADLINE_TINYML_BUDGET_US     500000   ///< Whole pipeline (~200-500 ms worst case)
+#define DEADLINE_TINYML_TOLERANCE_MS  1000     ///< Inference timing is not critical
+
+/* ====== Deferred Logger ====== */
+
+/**
+ * @brief Hot-path logging through a lock-free ring drained by the LOG task
+ * @details 1 = DLOG_* calls store a format pointer + binary arguments and
+ *          return; 0 = DLOG_* calls Serial.printf synchronously (original
+ *          behavior, no LOG task)
+ */
+#ifndef DEFERRED_LOG_ENABLED
+  #define DEFERRED_LOG_ENABLED 1
+#endif
+
+/**
+ * @brief Compile-time log level; DLOG_* sites above it are removed entirely
+ */
+#define DLOG_LEVEL_NONE   0
+#define DLOG_LEVEL_ERROR  1
+#define DLOG_LEVEL_WARN   2
+#define DLOG_LEVEL_INFO   3
+#define DLOG_LEVEL_DEBUG  4   ///< Per-refresh messages (LCD updates, NeoPixel colors)
+
+#ifndef DLOG_LEVEL
+  #define DLOG_LEVEL DLOG_LEVEL_INFO
+#endif
+
+#define DLOG_QUEUE_LEN   64    ///< Ring slots (power of two, 40 bytes each)
+#define DLOG_MAX_ARGS    6     ///< Arguments per record
+#define DLOG_DRAIN_MS    20    ///< LOG task polling period
+#define DLOG_LINE_MAX    192   ///< Longest formatted line
+
+/**
+ * @brief Print Serial.printf vs deferred cost per call at startup
+ * @note Built by the [env:bench_log] PlatformIO environment
+ */
+#ifndef DLOG_BENCH
+  #define DLOG_BENCH 0
+#endif
+
+/* ====== Trace Recorder ====== */
+
+/**
+ * @brief Binary event trace (give/take, job runs, task switches, I2C, HTTP)
+ * @details Flight recorder of TRACE_BUFFER_EVENTS 12-byte records, dumped
+ *          by GET /trace and converted with tools/trace2perfetto.py; cheap
+ *          enough to stay enabled (one atomic add + three stores per event)
+ */
+#ifndef TRACE_ENABLED
+  #define TRACE_ENABLED 1
+#endif
+
+#define TRACE_BUFFER_EVENTS  512   ///< Ring size (power of two, 6 KB)
+#define TRACE_MAX_LABELS     32    ///< Distinct job/event/device/route names
+#define TRACE_SYNC_TICKS     100   ///< Ticks between per-core time sync events
+
+/* ====== Executor Benchmark ====== */
+
+/**
+ * @brief Print RAM, context switch and event latency figures for the
+ *        current EXECUTOR_MODE after EXEC_BENCH_DURATION_MS
+ * @note Built by the [env:bench_exec_*] PlatformIO environments
+ */
+#ifndef EXECUTOR_BENCH
+  #define EXECUTOR_BENCH 0
+#endif
+
+#define EXEC_BENCH_DURATION_MS  30000  ///< Measurement window
+
+/* ====== NeoPixel Render Benchmark ====== */
+
+/**
+ * @brief Print DEMO render cycles per frame, float sin() vs lookup table,
+ *        for 4-300 LEDs when the UI strip starts
+ * @note Built by the [env:bench_neo_render] PlatformIO environment
+ */
+#ifndef NEO_RENDER_BENCH
+  #define NEO_RENDER_BENCH 0
+#endif
+
+/* ====== LCD Bus Benchmark ====== */
+
+/**
+ * @brief Print µs per character and per full-screen update, LIBRARY vs
+ *        BATCHED backend, when the LCD task starts
+ * @note Built by the [env:bench_lcd] PlatformIO environment
+ */
+#ifndef LCD_BENCH
+  #define LCD_BENCH 0
+#endif
+
+/* ====== Latency Benchmark ====== */
+
+/**
+ * @brief Producer → consumer latency per synchronization edge
+ * @details See tasks/latency_bench.h; a stimulus task forces band and
+ *          humidity changes and the report is printed after
+ *          LAT_BENCH_DURATION_MS. TinyML load is set with
+ *          TINYML_INFERENCE_MS (e.g. 20 for back-to-back inference)
+ * @note Built by the [env:bench_latency*] PlatformIO environments
+ */
+#ifndef LATENCY_BENCH
+  #define LATENCY_BENCH 0
+#endif
+
+#define LAT_LOAD_HTTP   0x01   ///< Loopback GET /state flood
+#define LAT_LOAD_CPU    0x02   ///< Placement benchmark burner on each core
+
+#ifndef LATENCY_BENCH_LOAD
+  #define LATENCY_BENCH_LOAD 0
+#endif
+
+#define LAT_BENCH_DURATION_MS     60000  ///< Measurement window
+#define LAT_BENCH_STIMULUS_MS     100    ///< Forced band/hum change period (+0-7 ms)
+#define LAT_BENCH_HTTP_PERIOD_MS  5      ///< Pause between flood requests
+
+/* ====== Statistical Anomaly Detector ====== */
+
+/**
+ * @brief Streaming detector parameters (see ml/stat_anomaly.h)
+ * @details Runs on every DHT20 reading; fallback when TinyML is unavailable
+ */
+#define STAT_WARMUP_SAMPLES  20     ///< Readings before scores are published (10 s)
+#define STAT_EWMA_ALPHA      0.05f  ///< EWMA smoothing (~20-sample memory)
+#define STAT_Z_ALARM         4.0f   ///< |z| that maps to score 0.5
+#define STAT_CUSUM_K         0.5f   ///< CUSUM slack (in standard deviations)
+#define STAT_CUSUM_H         8.0f   ///< CUSUM level that maps to score 0.5
+#define STAT_MIN_STD_TEMP    0.1f   ///< Noise floor for temperature (°C)
+#define STAT_MIN_STD_HUM     0.5f   ///< Noise floor for humidity (%)
 
 #endif // CONFIG_H
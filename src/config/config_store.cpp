@@ -0,0 +1,217 @@
+/**
+ * @file config_store.cpp
+ * @brief Config Store - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "config_store.h"
+#include <Preferences.h>
+#include <atomic>
+#include <stddef.h>
+#include "esp_rom_crc.h"
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint8_t kSlots = 3;                    ///< Current + one spare + one pinned by a slow reader
+    constexpr const char* kNamespace = "sysconfig";
+    constexpr const char* kKey = "cfg";
+
+    /**
+     * @brief NVS blob
+     */
+    struct StoredConfig {
+        uint16_t schema;                             ///< CONFIG_SCHEMA_VERSION
+        uint16_t size;                               ///< sizeof(SysConfig)
+        SysConfig cfg;
+        uint32_t crc;                                ///< CRC32 of everything above
+    };
+
+    SysConfig slots[kSlots];
+    std::atomic<uint8_t> pins[kSlots];               ///< Readers per slot
+    std::atomic<const SysConfig*> current{nullptr};
+
+    StoredConfig saved;                              ///< Last blob written or loaded
+    bool savedValid = false;
+    bool dirty = false;
+    uint32_t firstDirtyMs = 0;
+    uint32_t lastChangeMs = 0;
+    ConfigStoreStatus stat = { "defaults", 0, 0, 0, 0, false, 0 };
+
+    uint32_t blobCrc(const StoredConfig& s) {
+        return esp_rom_crc32_le(0, (const uint8_t*)&s, offsetof(StoredConfig, crc));
+    }
+
+    /**
+     * @brief Thresholds must be strictly increasing within each set
+     */
+    bool plausible(const SysConfig& c) {
+        return c.tColdMax < c.tNormalMax && c.tNormalMax < c.tHotMax &&
+               c.hDryMax < c.hComfMax && c.hComfMax < c.hHumidMax &&
+               c.wifiMode <= CFG_WIFI_STA;
+    }
+
+    /**
+     * @brief Copy next into a slot nobody reads and swap the pointer
+     */
+    void publish(const SysConfig& next) {
+        const SysConfig* cur = current.load();
+        for (;;) {
+            for (uint8_t s = 0; s < kSlots; s++) {
+                if (&slots[s] == cur || pins[s].load() != 0) continue;
+                memcpy(&slots[s], &next, sizeof(SysConfig));
+                current.store(&slots[s]);            // Readers see the whole copy or the old one
+                stat.publishes++;
+                return;
+            }
+            vTaskDelay(1);                           // Spare slots pinned by preempted readers
+        }
+    }
+
+    void save() {
+        StoredConfig blob;
+        memset(&blob, 0, sizeof(blob));
+        blob.schema = CONFIG_SCHEMA_VERSION;
+        blob.size = sizeof(SysConfig);
+        {
+            ConfigSnapshot cfg;
+            memcpy(&blob.cfg, &*cfg, sizeof(SysConfig));
+        }
+        blob.crc = blobCrc(blob);
+
+        if (savedValid && memcmp(&blob, &saved, sizeof(blob)) == 0) {
+            stat.skipped++;
+            dirty = false;
+            return;
+        }
+        Preferences prefs;
+        if (!prefs.begin(kNamespace, false) || prefs.putBytes(kKey, &blob, sizeof(blob)) != sizeof(blob)) {
+            prefs.end();
+            // Stay dirty and retry after another CONFIG_SAVE_DELAY_MS
+            stat.failures++;
+            firstDirtyMs = lastChangeMs = millis();
+            Serial.printf("[CFG] ✗ NVS write failed (failure #%u), retrying\n", (unsigned)stat.failures);
+            return;
+        }
+        prefs.end();
+        dirty = false;
+        saved = blob;
+        savedValid = true;
+        stat.saves++;
+        Serial.printf("[CFG] Saved to NVS (schema %u, %u B, save #%u)\n",
+                      (unsigned)blob.schema, (unsigned)sizeof(blob), (unsigned)stat.saves);
+    }
+
+    /**
+     * @brief Read and check the NVS blob
+     * @return nullptr when valid, else why it was rejected
+     */
+    const char* load(StoredConfig& blob) {
+        Preferences prefs;
+        if (!prefs.begin(kNamespace, true)) return "defaults (nothing stored)";
+        size_t len = prefs.getBytesLength(kKey);
+        const char* err = nullptr;
+        if (len == 0) err = "defaults (nothing stored)";
+        else if (len != sizeof(blob)) err = "defaults (blob size changed)";
+        else if (prefs.getBytes(kKey, &blob, sizeof(blob)) != sizeof(blob)) err = "defaults (read failed)";
+        prefs.end();
+        if (err) return err;
+
+        if (blob.schema != CONFIG_SCHEMA_VERSION || blob.size != sizeof(SysConfig)) return "defaults (other schema)";
+        if (blob.crc != blobCrc(blob)) return "defaults (CRC mismatch)";
+        if (!plausible(blob.cfg)) return "defaults (invalid thresholds)";
+        blob.cfg.staSsid[sizeof(blob.cfg.staSsid) - 1] = '\0';
+        blob.cfg.staPass[sizeof(blob.cfg.staPass) - 1] = '\0';
+        return nullptr;
+    }
+} // namespace
+
+/* ====== Snapshots ====== */
+
+ConfigSnapshot::ConfigSnapshot() {
+    for (;;) {
+        const SysConfig* p = current.load();
+        uint8_t s = (uint8_t)(p - slots);
+        pins[s].fetch_add(1);
+        // Still current after pinning: the writer cannot reuse the slot now
+        if (current.load() == p) {
+            cfg = p;
+            slot = s;
+            return;
+        }
+        pins[s].fetch_sub(1);
+    }
+}
+
+ConfigSnapshot::~ConfigSnapshot() {
+    pins[slot].fetch_sub(1);
+}
+
+/* ====== Public Functions ====== */
+
+SysConfig configDefaults() {
+    SysConfig c;
+    memset(&c, 0, sizeof(c));
+    c.tColdMax   = DEFAULT_T_COLD_MAX;
+    c.tNormalMax = DEFAULT_T_NORMAL_MAX;
+    c.tHotMax    = DEFAULT_T_HOT_MAX;
+    c.hDryMax    = DEFAULT_H_DRY_MAX;
+    c.hComfMax   = DEFAULT_H_COMF_MAX;
+    c.hHumidMax  = DEFAULT_H_HUMID_MAX;
+    c.wifiMode   = CFG_WIFI_AP;
+    return c;
+}
+
+void configInit() {
+    SysConfig defaults = configDefaults();
+    memcpy(&slots[0], &defaults, sizeof(SysConfig));
+    current.store(&slots[0]);
+
+    StoredConfig blob;
+    const char* err = load(blob);
+    if (err) {
+        stat.source = err;
+        Serial.printf("[CFG] Using %s\n", err);
+        return;
+    }
+    publish(blob.cfg);
+    saved = blob;
+    savedValid = true;
+    stat.source = "nvs";
+    Serial.printf("[CFG] Loaded from NVS (schema %u): T %.1f/%.1f/%.1f H %.1f/%.1f/%.1f WiFi %s\n",
+                  (unsigned)blob.schema, blob.cfg.tColdMax, blob.cfg.tNormalMax, blob.cfg.tHotMax,
+                  blob.cfg.hDryMax, blob.cfg.hComfMax, blob.cfg.hHumidMax, configWifiModeName(blob.cfg.wifiMode));
+}
+
+void configPublish(const SysConfig& next) {
+    publish(next);
+    uint32_t now = millis();
+    if (!dirty) firstDirtyMs = now;
+    lastChangeMs = now;
+    dirty = true;
+}
+
+void configService() {
+    if (!dirty) return;
+    uint32_t now = millis();
+    if (now - lastChangeMs < CONFIG_SAVE_DELAY_MS && now - firstDirtyMs < CONFIG_SAVE_MAX_DELAY_MS) return;
+    save();
+}
+
+void configStatus(ConfigStoreStatus& dst) {
+    dst = stat;
+    dst.dirty = dirty;
+    dst.saveInMs = 0;
+    if (dirty) {
+        uint32_t now = millis();
+        uint32_t quiet = lastChangeMs + CONFIG_SAVE_DELAY_MS - now;
+        uint32_t cap = firstDirtyMs + CONFIG_SAVE_MAX_DELAY_MS - now;
+        int32_t left = (int32_t)(quiet < cap ? quiet : cap);
+        dst.saveInMs = left > 0 ? (uint32_t)left : 0;
+    }
+}
+
+const char* configWifiModeName(uint8_t mode) {
+    return mode == CFG_WIFI_STA ? "sta" : "ap";
+}
@@ -0,0 +1,127 @@
+/**
+ * @file config_store.h
+ * @brief Config Store - Persistent, versioned configuration with atomic snapshots
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The band thresholds and the WiFi settings form one SysConfig. The
+ * current SysConfig is an immutable snapshot reached through an atomic
+ * pointer:
+ * - Readers (classifyTemp/classifyHum, web) pin it with ConfigSnapshot
+ *   and read a consistent set without taking a lock
+ * - The writer copies the snapshot, edits the copy and publishes it with
+ *   configPublish(): the copy goes into a spare slot and the pointer is
+ *   swapped. A slot is reused only once no reader has it pinned
+ *
+ * Snapshots are saved to NVS (Preferences) as one blob with a schema
+ * version and a CRC32, and loaded at boot. A blob that is missing, has
+ * another schema version or fails the CRC is ignored (defaults are used).
+ *
+ * Writes to flash are coalesced: a change is saved once no other change
+ * followed for CONFIG_SAVE_DELAY_MS, at the latest CONFIG_SAVE_MAX_DELAY_MS
+ * after the first unsaved change, and not at all when the blob is
+ * unchanged. A failed write leaves the snapshot dirty and is retried.
+ *
+ * @note Single writer: configPublish() and configService() run in the
+ *       web server context (loop() or the WEB task), configInit() at boot
+ * @note WiFi credentials are stored unencrypted (no NVS encryption)
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * @brief WiFi mode restored at boot
+ */
+enum CfgWifiMode : uint8_t {
+    CFG_WIFI_AP = 0,    ///< Access point (default)
+    CFG_WIFI_STA,       ///< Join staSsid, fall back to the AP
+};
+
+/**
+ * @brief Runtime configuration (one immutable snapshot)
+ * @note No implicit padding: snapshots are compared and CRC'd as bytes
+ */
+struct SysConfig {
+    float tColdMax;         ///< Upper limit of COLD band (°C)
+    float tNormalMax;       ///< Upper limit of NORMAL band (°C)
+    float tHotMax;          ///< Upper limit of HOT band (°C), above = CRITICAL
+    float hDryMax;          ///< Upper limit of DRY band (%)
+    float hComfMax;         ///< Upper limit of COMFORT band (%)
+    float hHumidMax;        ///< Upper limit of HUMID band (%), above = WET
+    char staSsid[33];       ///< Station mode network
+    char staPass[65];
+    uint8_t wifiMode;       ///< CfgWifiMode
+    uint8_t reserved;
+};
+
+static_assert(sizeof(SysConfig) == 6 * sizeof(float) + 33 + 65 + 2, "SysConfig must not contain padding");
+
+/**
+ * @brief Store counters (read by GET /config)
+ */
+struct ConfigStoreStatus {
+    const char* source;     ///< "nvs" or why the defaults were used
+    uint32_t publishes;     ///< Snapshots published since boot
+    uint32_t saves;         ///< NVS writes
+    uint32_t skipped;       ///< Due saves dropped because the blob was unchanged
+    uint32_t failures;      ///< NVS writes that failed (the snapshot stays dirty)
+    bool dirty;             ///< Published snapshot not saved yet
+    uint32_t saveInMs;      ///< Time until the pending save
+};
+
+/**
+ * @brief Pins the current configuration for the lifetime of the object
+ * @details Lock-free; keep it short-lived (a function scope)
+ */
+class ConfigSnapshot {
+public:
+    ConfigSnapshot();
+    ~ConfigSnapshot();
+    ConfigSnapshot(const ConfigSnapshot&) = delete;
+    ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+    const SysConfig* operator->() const { return cfg; }
+    const SysConfig& operator*() const { return *cfg; }
+
+private:
+    const SysConfig* cfg;
+    uint8_t slot;
+};
+
+/**
+ * @brief Factory configuration (DEFAULT_* in config.h, AP mode)
+ */
+SysConfig configDefaults();
+
+/**
+ * @brief Load the stored configuration and publish it
+ * @note Call once during setup(), before initWiFi() and the tasks
+ */
+void configInit();
+
+/**
+ * @brief Publish a new snapshot and schedule it for saving
+ */
+void configPublish(const SysConfig& next);
+
+/**
+ * @brief Save the configuration when the coalescing delay has passed
+ * @note Called by handleWebServer()
+ */
+void configService();
+
+/**
+ * @brief Copy the store counters
+ */
+void configStatus(ConfigStoreStatus& dst);
+
+/**
+ * @brief "ap" or "sta"
+ */
+const char* configWifiModeName(uint8_t mode);
+
+#endif // CONFIG_STORE_H
@@ -5,7 +5,7 @@
  * @date 2025
  * 
  * This file implements:
- * - Global system state variables (shared between tasks and web server)
+ * - Global live state (shared between tasks and web server)
  * - Temperature/humidity classification functions
  * - LED blink pattern mapping
  * - String conversion utilities for enums
@@ -26,45 +26,6 @@
  */
 volatile LiveState gLive;
 
-/**
- * @brief Current WiFi mode ("ap" or "sta")
- * @details "ap" = Access Point mode (ESP32 creates network)
- *          "sta" = Station mode (ESP32 connects to existing network)
- */
-String gWifiMode = "ap";
-
-/**
- * @brief Station mode SSID (when connecting to external WiFi)
- * @note Empty string when in AP mode
- */
-String gStaSsid  = "";
-
-/**
- * @brief Station mode password (when connecting to external WiFi)
- * @note Empty string when in AP mode
- */
-String gStaPass  = "";
-
-/**
- * @brief Runtime-modifiable temperature thresholds
- * @details Initialized from DEFAULT_* constants in config.h
- *          Can be updated via web API (/set endpoint)
- * @note Changes take effect immediately in classification logic
- */
-float T_COLD_MAX   = DEFAULT_T_COLD_MAX;    ///< Upper limit of COLD band (default 20°C)
-float T_NORMAL_MAX = DEFAULT_T_NORMAL_MAX;  ///< Upper limit of NORMAL band (default 30°C)
-float T_HOT_MAX    = DEFAULT_T_HOT_MAX;     ///< Upper limit of HOT band (default 40°C)
-
-/**
- * @brief Runtime-modifiable humidity thresholds
- * @details Initialized from DEFAULT_* constants in config.h
- *          Can be updated via web API (/set endpoint)
- * @note Changes take effect immediately in classification logic
- */
-float H_DRY_MAX    = DEFAULT_H_DRY_MAX;     ///< Upper limit of DRY band (default 40%)
-float H_COMF_MAX   = DEFAULT_H_COMF_MAX;    ///< Upper limit of COMFORT band (default 60%)
-float H_HUMID_MAX  = DEFAULT_H_HUMID_MAX;   ///< Upper limit of HUMID band (default 80%)
-
 /* ====== Helper Function Implementations ====== */
 
 /**
@@ -103,36 +64,38 @@ const char* humName(HumBand b) {
  * @brief Classify temperature reading into band
  * @param tC Temperature in degrees Celsius
  * @return Temperature band enum (COLD, NORMAL, HOT, or CRITICAL)
- * @details Uses runtime-modifiable thresholds:
- *          - tC < T_COLD_MAX → COLD
- *          - tC < T_NORMAL_MAX → NORMAL
- *          - tC < T_HOT_MAX → HOT
- *          - tC ≥ T_HOT_MAX → CRITICAL
+ * @details Uses the published config snapshot:
+ *          - tC < tColdMax → COLD
+ *          - tC < tNormalMax → NORMAL
+ *          - tC < tHotMax → HOT
+ *          - tC ≥ tHotMax → CRITICAL
  * @note This function is called by Task 1 (sensor) on every reading
  */
 TempBand classifyTemp(float tC) {
-    if (tC < T_COLD_MAX)   return TempBand::COLD;
-    if (tC < T_NORMAL_MAX) return TempBand::NORMAL;
-    if (tC < T_HOT_MAX)    return TempBand::HOT;
-    return TempBand::CRITICAL;  // Temperature ≥ T_HOT_MAX
+    ConfigSnapshot cfg;   // One consistent threshold set, no lock
+    if (tC < cfg->tColdMax)   return TempBand::COLD;
+    if (tC < cfg->tNormalMax) return TempBand::NORMAL;
+    if (tC < cfg->tHotMax)    return TempBand::HOT;
+    return TempBand::CRITICAL;  // Temperature ≥ tHotMax
 }
 
 /**
  * @brief Classify humidity reading into band
  * @param h Humidity in percentage (0-100%)
  * @return Humidity band enum (DRY, COMFORT, HUMID, or WET)
- * @details Uses runtime-modifiable thresholds:
- *          - h < H_DRY_MAX → DRY
- *          - h < H_COMF_MAX → COMFORT
- *          - h < H_HUMID_MAX → HUMID
- *          - h ≥ H_HUMID_MAX → WET
+ * @details Uses the published config snapshot:
+ *          - h < hDryMax → DRY
+ *          - h < hComfMax → COMFORT
+ *          - h < hHumidMax → HUMID
+ *          - h ≥ hHumidMax → WET
  * @note This function is called by Task 1 (sensor) on every reading
  */
 HumBand classifyHum(float h) {
-    if (h < H_DRY_MAX)     return HumBand::DRY;
-    if (h < H_COMF_MAX)    return HumBand::COMFORT;
-    if (h < H_HUMID_MAX)   return HumBand::HUMID;
-    return HumBand::WET;  // Humidity ≥ H_HUMID_MAX
+    ConfigSnapshot cfg;
+    if (h < cfg->hDryMax)     return HumBand::DRY;
+    if (h < cfg->hComfMax)    return HumBand::COMFORT;
+    if (h < cfg->hHumidMax)   return HumBand::HUMID;
+    return HumBand::WET;  // Humidity ≥ hHumidMax
 }
 
 /**
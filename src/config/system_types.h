@@ -7,7 +7,6 @@
  * This header defines:
  * - Temperature and humidity band classifications
  * - Global system state structure (LiveState)
- * - Configuration variables (WiFi, thresholds)
  * - Helper function prototypes for classification and conversion
  * 
  * This file is included by all modules that need access to system state.
@@ -18,16 +17,17 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "config_store.h"
 
 /* ====== Enumerations ====== */
 
 /**
  * @brief Temperature classification bands
  * @details Four levels based on configurable thresholds:
- *          - COLD (0): Below T_COLD_MAX (default < 20°C)
- *          - NORMAL (1): Between T_COLD_MAX and T_NORMAL_MAX (20-30°C)
- *          - HOT (2): Between T_NORMAL_MAX and T_HOT_MAX (30-40°C)
- *          - CRITICAL (3): Above T_HOT_MAX (default > 40°C)
+ *          - COLD (0): Below tColdMax (default < 20°C)
+ *          - NORMAL (1): Between tColdMax and tNormalMax (20-30°C)
+ *          - HOT (2): Between tNormalMax and tHotMax (30-40°C)
+ *          - CRITICAL (3): Above tHotMax (default > 40°C)
  * @note Used to trigger different LED blink patterns
  */
 enum class TempBand : uint8_t { 
@@ -40,10 +40,10 @@ enum class TempBand : uint8_t {
 /**
  * @brief Humidity classification bands
  * @details Four levels based on configurable thresholds:
- *          - DRY (0): Below H_DRY_MAX (default < 40%)
- *          - COMFORT (1): Between H_DRY_MAX and H_COMF_MAX (40-60%)
- *          - HUMID (2): Between H_COMF_MAX and H_HUMID_MAX (60-80%)
- *          - WET (3): Above H_HUMID_MAX (default > 80%)
+ *          - DRY (0): Below hDryMax (default < 40%)
+ *          - COMFORT (1): Between hDryMax and hComfMax (40-60%)
+ *          - HUMID (2): Between hComfMax and hHumidMax (60-80%)
+ *          - WET (3): Above hHumidMax (default > 80%)
  * @note Used to determine NeoPixel color (blue → green → yellow → red)
  */
 enum class HumBand : uint8_t { 
@@ -73,6 +73,9 @@ struct LiveState {
     uint8_t ledOn = 0;           ///< LED state: 0=off, 1=on
     uint32_t onMs = 300;         ///< LED on-time duration in milliseconds
     uint32_t offMs = 300;        ///< LED off-time duration in milliseconds
+    uint32_t led_edges = 0;      ///< Blink edges driven (timer callback or LED task)
+    uint32_t led_jitter_avg_us = 0;  ///< Mean blink edge lateness vs schedule
+    uint32_t led_jitter_max_us = 0;  ///< Worst blink edge lateness vs schedule
     
     // Semaphore telemetry (debugging/monitoring)
     uint32_t giveTemp = 0;       ///< Count of semBandChanged given (by Task 1)
@@ -81,7 +84,7 @@ struct LiveState {
     uint32_t takeHum  = 0;       ///< Count of semHumChanged taken (by Task 3)
     
     // UI control (from web dashboard)
-    uint8_t uiMode = 0;          ///< NeoPixel UI mode: 0=off, 1=bar, 2=demo, 3=sos, 4=blink
+    uint8_t uiMode = 0;          ///< NeoPixel UI mode: 0=off, 1=bar, 2=demo, 3=sos, 4=blink, 5=pattern
     
     // Task timing monitor (for performance analysis)
     uint32_t dht_last_ms = 0;    ///< Timestamp of last DHT20 reading (millis)
@@ -97,6 +100,14 @@ struct LiveState {
     float tinyml_score = NAN;    ///< Latest anomaly detection score (0.0-1.0)
     uint32_t tinyml_last_ms = 0; ///< Timestamp of last inference (millis)
     uint32_t tinyml_runs = 0;    ///< Total inference executions
+    uint8_t tinyml_ready = 0;    ///< 1 once the interpreter is initialized
+    
+    // Streaming statistical detector (from Task 1)
+    float stat_score = NAN;      ///< Statistical anomaly score (0.0-1.0)
+    uint32_t stat_cycles = 0;    ///< CPU cycles spent on the last update
+
+    // Deadline monitor (DL_ESCALATE_ALERT and above)
+    uint8_t deadline_alert = 0;  ///< 1 while a periodic task keeps missing its deadline/budget
 };
 
 /* ====== Global Variables ====== */
@@ -107,62 +118,8 @@ struct LiveState {
  */
 extern volatile LiveState gLive;
 
-// WiFi configuration (runtime modifiable)
-
-/**
- * @brief Current WiFi mode ("ap" or "sta")
- */
-extern String gWifiMode;
-
-/**
- * @brief Station mode target SSID
- */
-extern String gStaSsid;
-
-/**
- * @brief Station mode WiFi password
- */
-extern String gStaPass;
-
-// Temperature thresholds (runtime modifiable via web API)
-
-/**
- * @brief Upper temperature limit of COLD band (°C)
- * @note Can be modified via /set API endpoint
- */
-extern float T_COLD_MAX;
-
-/**
- * @brief Upper temperature limit of NORMAL band (°C)
- * @note Can be modified via /set API endpoint
- */
-extern float T_NORMAL_MAX;
-
-/**
- * @brief Upper temperature limit of HOT band (°C)
- * @note Above this is CRITICAL; can be modified via /set API endpoint
- */
-extern float T_HOT_MAX;
-
-// Humidity thresholds (runtime modifiable via web API)
-
-/**
- * @brief Upper humidity limit of DRY band (%)
- * @note Can be modified via /set API endpoint
- */
-extern float H_DRY_MAX;
-
-/**
- * @brief Upper humidity limit of COMFORT band (%)
- * @note Can be modified via /set API endpoint
- */
-extern float H_COMF_MAX;
-
-/**
- * @brief Upper humidity limit of HUMID band (%)
- * @note Above this is WET; can be modified via /set API endpoint
- */
-extern float H_HUMID_MAX;
+// WiFi settings and band thresholds live in the config store
+// (config_store.h): read them through a ConfigSnapshot
 
 /* ====== Helper Functions ====== */
 
@@ -80,6 +80,14 @@ SemaphoreHandle_t semHumChanged = NULL;
  */
 SemaphoreHandle_t semLcdUpdate = NULL;
 
+/**
+ * @brief Binary semaphore for UI mode changes
+ * @details The web handlers (and Task 1's SOS auto-reset) give this after
+ *          changing gLive.uiMode, so Task 4 wakes from a long keyframe sleep
+ *          Flow: Web → semUiMode → Task4
+ */
+SemaphoreHandle_t semUiMode = NULL;
+
 /* ====== Initialization Functions ====== */
 
 /**
@@ -123,10 +131,11 @@ void initHardware() {
 
 /**
  * @brief Initialize FreeRTOS binary semaphores for inter-task communication
- * @details Creates three binary semaphores:
+ * @details Creates four binary semaphores:
  *          - semBandChanged: Temperature band change notification
  *          - semHumChanged: Humidity band change notification
  *          - semLcdUpdate: LCD display update trigger
+ *          - semUiMode: NeoPixel UI mode change
  * 
  * Binary semaphores behavior:
  * - Initial state: Empty (must be given before taking)
@@ -139,13 +148,22 @@ void initHardware() {
 void initSemaphores() {
     // Create binary semaphores (not counting semaphores)
     // Binary semaphores can be given/taken only once before needing to be reset
+#if STATIC_ALLOCATION
+    static StaticSemaphore_t semBuffers[4];
+    semBandChanged = xSemaphoreCreateBinaryStatic(&semBuffers[0]);
+    semHumChanged  = xSemaphoreCreateBinaryStatic(&semBuffers[1]);
+    semLcdUpdate   = xSemaphoreCreateBinaryStatic(&semBuffers[2]);
+    semUiMode      = xSemaphoreCreateBinaryStatic(&semBuffers[3]);
+#else
     semBandChanged = xSemaphoreCreateBinary();
     semHumChanged  = xSemaphoreCreateBinary();
     semLcdUpdate   = xSemaphoreCreateBinary();
+    semUiMode      = xSemaphoreCreateBinary();
+#endif
     
     // Verify all semaphores were created successfully
     // NULL indicates memory allocation failure
-    if (semBandChanged == NULL || semHumChanged == NULL || semLcdUpdate == NULL) {
+    if (semBandChanged == NULL || semHumChanged == NULL || semLcdUpdate == NULL || semUiMode == NULL) {
         Serial.println("[ERROR] Failed to create semaphores!");
         // System continues but tasks will hang on xSemaphoreTake()
     } else {
@@ -86,6 +86,13 @@ extern SemaphoreHandle_t semHumChanged;
  */
 extern SemaphoreHandle_t semLcdUpdate;
 
+/**
+ * @brief Binary semaphore: NeoPixel UI mode changed
+ * @details Given by: web UI handlers, Task 1 (SOS auto-reset)
+ *          Taken by: Task 4 (NeoPixel UI) to leave a keyframe sleep early
+ */
+extern SemaphoreHandle_t semUiMode;
+
 /* ====== Initialization ====== */
 
 /**
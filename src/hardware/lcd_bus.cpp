@@ -0,0 +1,188 @@
+/**
+ * @file lcd_bus.cpp
+ * @brief LCD Bus - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "lcd_bus.h"
+#include "hardware_manager.h"
+#include "esp_timer.h"
+
+#ifndef I2C_BUFFER_LENGTH
+  #define I2C_BUFFER_LENGTH 32   // Wire implementations without the macro
+#endif
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint8_t kRs = 0x01;                  ///< P0: 0 = command, 1 = data
+    constexpr uint8_t kEn = 0x04;                  ///< P2: latched on the falling edge
+    constexpr uint8_t kBacklight = 0x08;           ///< P3
+    constexpr uint8_t kSetCgramAddr = 0x40;
+    constexpr uint8_t kSetDdramAddr = 0x80;
+    constexpr uint8_t kRowOffsets[] = { 0x00, 0x40, 0x14, 0x54 };
+    constexpr uint32_t kLibraryBytesPerLcdByte = 12;   ///< 2 nibbles × 3 writes × (address + data)
+    constexpr uint8_t kNoRs = 0xFF;
+
+    uint32_t wireBytes = 0;
+
+    /* ---- LIBRARY: LiquidCrystal_I2C ---- */
+
+    void libraryCommand(uint8_t v) {
+        lcd.command(v);
+        wireBytes += kLibraryBytesPerLcdByte;
+    }
+
+    void libraryData(uint8_t v) {
+        lcd.write(v);
+        wireBytes += kLibraryBytesPerLcdByte;
+    }
+
+    void libraryFlush() {}
+
+    /* ---- BATCHED: one transaction per burst ---- */
+
+    uint8_t burst[I2C_BUFFER_LENGTH];
+    size_t burstLen = 0;
+    uint8_t lineRs = kNoRs;                        ///< RS level on the expander
+
+    void batchedFlush() {
+        if (burstLen == 0) return;
+        Wire.beginTransmission(LCD_I2C_ADDR);
+        Wire.write(burst, burstLen);
+        Wire.endTransmission();
+        wireBytes += burstLen + 1;
+        burstLen = 0;
+    }
+
+    inline void put(uint8_t pins) {
+        if (burstLen == sizeof(burst)) batchedFlush();
+        burst[burstLen++] = pins | kBacklight;
+    }
+
+    inline void nibble(uint8_t pins) {
+        put(pins | kEn);
+        put(pins);                                  // Falling edge latches D4-D7
+    }
+
+    void batchedSend(uint8_t v, uint8_t rs) {
+        if (rs != lineRs) {
+            put(rs);                                // RS settles before E rises
+            lineRs = rs;
+        }
+        nibble((v & 0xF0) | rs);
+        nibble((uint8_t)(v << 4) | rs);
+    }
+
+    void batchedCommand(uint8_t v) {
+        batchedSend(v, 0);
+    }
+
+    void batchedData(uint8_t v) {
+        batchedSend(v, kRs);
+    }
+
+    /**
+     * @brief Backend table (indexed by LCD_BACKEND)
+     */
+    const struct Backend {
+        const char* name;
+        void (*command)(uint8_t);
+        void (*data)(uint8_t);
+        void (*flush)();
+    } kBackends[] = {
+        { "library", libraryCommand, libraryData, libraryFlush },
+        { "batched", batchedCommand, batchedData, batchedFlush },
+    };
+
+    const Backend& active = kBackends[LCD_BACKEND];
+
+    inline uint8_t ddramAddr(uint8_t col, uint8_t row) {
+        return kSetDdramAddr | (uint8_t)(col + kRowOffsets[row < LCD_ROWS ? row : LCD_ROWS - 1]);
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+const char* lcdBusName() {
+    return active.name;
+}
+
+void lcdBusSetCursor(uint8_t col, uint8_t row) {
+    active.command(ddramAddr(col, row));
+}
+
+void lcdBusSetGlyph(uint8_t slot) {
+    active.command(kSetCgramAddr | (uint8_t)((slot & 7) << 3));
+}
+
+void lcdBusWrite(const char* text, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) active.data((uint8_t)text[i]);
+}
+
+void lcdBusFlush() {
+    active.flush();
+}
+
+uint32_t lcdBusWireBytes() {
+    return wireBytes;
+}
+
+/* ====== Benchmark ====== */
+
+#if LCD_BENCH
+
+void lcdBench() {
+    constexpr int kChars = 64;          ///< Written in one run (wraps in DDRAM, off screen)
+    constexpr int kScreens = 16;
+    static const char kRow[LCD_COLS + 1] = "0123456789ABCDEF";
+
+    Serial.printf("\n[LCD] ===== LCD bus cost (Wire %u kHz) =====\n", (unsigned)(Wire.getClock() / 1000));
+    Serial.println("[LCD]  backend   us/char  us/screen  I2C B/screen");
+
+    for (const Backend& b : kBackends) {
+        lineRs = kNoRs;
+
+        b.command(ddramAddr(0, 0));
+        int64_t t0 = esp_timer_get_time();
+        for (int i = 0; i < kChars; i++) b.data(kRow[i % LCD_COLS]);
+        b.flush();
+        float usPerChar = (float)(esp_timer_get_time() - t0) / kChars;
+
+        uint32_t bytes0 = wireBytes;
+        t0 = esp_timer_get_time();
+        for (int s = 0; s < kScreens; s++) {
+            for (uint8_t row = 0; row < LCD_ROWS; row++) {
+                b.command(ddramAddr(0, row));
+                for (int c = 0; c < LCD_COLS; c++) b.data(kRow[(c + s) % LCD_COLS]);
+            }
+            b.flush();
+        }
+        float usPerScreen = (float)(esp_timer_get_time() - t0) / kScreens;
+
+        Serial.printf("[LCD]  %-8s %7.1f %10.1f %13u\n", b.name, usPerChar, usPerScreen,
+                      (unsigned)((wireBytes - bytes0) / kScreens));
+    }
+
+    // Original LCD task refresh: clear() + both rows through the library
+    uint32_t bytes0 = wireBytes;
+    int64_t t0 = esp_timer_get_time();
+    for (int s = 0; s < kScreens; s++) {
+        lcd.clear();
+        wireBytes += kLibraryBytesPerLcdByte;
+        for (uint8_t row = 0; row < LCD_ROWS; row++) {
+            libraryCommand(ddramAddr(0, row));
+            for (int c = 0; c < LCD_COLS; c++) libraryData(kRow[(c + s) % LCD_COLS]);
+        }
+    }
+    Serial.printf("[LCD]  %-8s %7s %10.1f %13u\n", "+clear", "-",
+                  (float)(esp_timer_get_time() - t0) / kScreens, (unsigned)((wireBytes - bytes0) / kScreens));
+    lineRs = kNoRs;
+}
+
+#else
+
+void lcdBench() {}
+
+#endif // LCD_BENCH
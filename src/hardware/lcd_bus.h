@@ -0,0 +1,72 @@
+/**
+ * @file lcd_bus.h
+ * @brief LCD Bus - HD44780 writes through the PCF8574 I2C expander
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The PCF8574 drives the LCD in 4-bit mode (P0 RS, P2 E, P3 backlight,
+ * P4-P7 D4-D7), so every LCD byte is two nibbles, each latched by an E
+ * strobe. Two backends (LCD_BACKEND):
+ * - LIBRARY: LiquidCrystal_I2C, one Wire transaction per expander write
+ *   (data, E high, E low): 6 transactions, 12 wire bytes per LCD byte
+ * - BATCHED: the expander states are queued, strobe edges included, and
+ *   a whole burst is sent as one Wire transaction (the PCF8574 latches
+ *   every data byte of a transaction in turn): 4 bytes per LCD byte plus
+ *   one RS setup byte when RS changes, one address byte per transaction
+ *
+ * With BATCHED, two expander bytes (≥ 45 µs at 400 kHz) separate the last
+ * strobe of an LCD byte from the first strobe of the next one, more than
+ * the 37 µs the HD44780 needs to execute a write. clear() and home()
+ * (1.5 ms) stay on the library.
+ *
+ * LCD_BENCH prints µs per character and per full-screen update for both
+ * backends when the LCD task starts.
+ *
+ * @note Single writer: only the LCD task uses the bus (under PM_LOCK_I2C)
+ */
+
+#ifndef LCD_BUS_H
+#define LCD_BUS_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief Name of the backend selected at build time ("library" or "batched")
+ */
+const char* lcdBusName();
+
+/**
+ * @brief Move the LCD address counter
+ */
+void lcdBusSetCursor(uint8_t col, uint8_t row);
+
+/**
+ * @brief Point the address counter at the CGRAM rows of a custom glyph
+ * @param slot 0-7, shown by character codes slot and slot + 8
+ */
+void lcdBusSetGlyph(uint8_t slot);
+
+/**
+ * @brief Write characters (or CGRAM rows) at the address counter
+ */
+void lcdBusWrite(const char* text, uint8_t len);
+
+/**
+ * @brief End of a write burst: send what is queued (BATCHED)
+ */
+void lcdBusFlush();
+
+/**
+ * @brief I2C bytes put on the wire so far, address bytes included
+ * @note LIBRARY: counted as 12 per LCD byte
+ */
+uint32_t lcdBusWireBytes();
+
+/**
+ * @brief Print µs per character and per full screen for both backends
+ *        (LCD_BENCH); leaves the panel content undefined
+ */
+void lcdBench();
+
+#endif // LCD_BUS_H
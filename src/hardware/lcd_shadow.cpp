@@ -0,0 +1,148 @@
+/**
+ * @file lcd_shadow.cpp
+ * @brief LCD Shadow - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "lcd_shadow.h"
+#include "lcd_bus.h"
+#include "esp_timer.h"
+#include <stdarg.h>
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint32_t kLibraryBytesPerLcdByte = 12;   ///< 2 nibbles × 3 PCF8574 writes × (address + data)
+    constexpr int kNoCursor = -1;
+    constexpr uint8_t kGlyphs = 8;
+    constexpr uint8_t kGlyphRows = 8;
+
+    char back[LCD_ROWS][LCD_COLS];       ///< Next frame
+    char shown[LCD_ROWS][LCD_COLS];      ///< What the panel shows
+    uint8_t textLen[LCD_ROWS];           ///< Unpadded text length (full-rewrite cost)
+    bool valid = false;                  ///< shown[] reflects the panel
+    uint8_t glyphBack[kGlyphs][kGlyphRows];
+    uint8_t glyphShown[kGlyphs][kGlyphRows];
+    uint8_t glyphStaged = 0;             ///< Bit per slot: glyphBack[] holds a definition
+    uint8_t glyphValid = 0;              ///< Bit per slot: glyphShown[] reflects CGRAM
+    int cursorRow = kNoCursor;           ///< Panel address counter
+    int cursorCol = kNoCursor;
+    LcdShadowStat stat = {};
+
+    inline bool changed(int row, int col) {
+        return !valid || back[row][col] != shown[row][col];
+    }
+
+    /**
+     * @brief Upload the glyphs whose definition changed
+     * @details Consecutive slots share one CGRAM address command
+     */
+    void flushGlyphs() {
+        int next = -1;                   ///< Slot the CGRAM address counter points at
+        for (uint8_t slot = 0; slot < kGlyphs; slot++) {
+            uint8_t bit = 1u << slot;
+            if (!(glyphStaged & bit)) continue;
+            if ((glyphValid & bit) && memcmp(glyphBack[slot], glyphShown[slot], kGlyphRows) == 0) continue;
+
+            if (next != slot) lcdBusSetGlyph(slot);
+            lcdBusWrite((const char*)glyphBack[slot], kGlyphRows);
+            memcpy(glyphShown[slot], glyphBack[slot], kGlyphRows);
+            glyphValid |= bit;
+            stat.glyphUploads++;
+            next = slot + 1;
+        }
+        if (next >= 0) cursorRow = cursorCol = kNoCursor;   // Address counter left in CGRAM
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void lcdShadowInit() {
+    memset(back, ' ', sizeof(back));
+    memset(shown, ' ', sizeof(shown));
+    memset(textLen, 0, sizeof(textLen));
+    valid = true;
+    glyphStaged = glyphValid = 0;       // CGRAM survives init(): contents unknown
+    cursorRow = cursorCol = kNoCursor;
+}
+
+void lcdShadowPrintf(uint8_t row, const char* fmt, ...) {
+    if (row >= LCD_ROWS) return;
+    char text[LCD_COLS + 1];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    if (n < 0) n = 0;
+    if (n > LCD_COLS) n = LCD_COLS;
+
+    memcpy(back[row], text, n);
+    memset(back[row] + n, ' ', LCD_COLS - n);
+    textLen[row] = (uint8_t)n;
+}
+
+void lcdShadowGlyph(uint8_t slot, const uint8_t rows[8]) {
+    if (slot >= kGlyphs) return;
+    memcpy(glyphBack[slot], rows, kGlyphRows);
+    glyphStaged |= 1u << slot;
+}
+
+uint32_t lcdShadowFlush() {
+    int64_t t0 = esp_timer_get_time();
+    uint32_t wire0 = lcdBusWireBytes();
+    flushGlyphs();
+
+    for (int row = 0; row < LCD_ROWS; row++) {
+        int col = 0;
+        while (col < LCD_COLS) {
+            if (!changed(row, col)) {
+                col++;
+                continue;
+            }
+            // Extend the run, bridging gaps of one unchanged cell
+            int last = col;
+            for (int c = col + 1; c < LCD_COLS && c - last <= 2; c++) {
+                if (changed(row, c)) last = c;
+            }
+
+            if (row != cursorRow || col != cursorCol) {
+                lcdBusSetCursor(col, row);
+                stat.cursorMoves++;
+            }
+            int n = last - col + 1;
+            lcdBusWrite(&back[row][col], n);
+            memcpy(&shown[row][col], &back[row][col], n);
+            stat.chars += n;
+            cursorRow = row;
+            cursorCol = last + 1;
+            col = last + 1;
+        }
+    }
+    lcdBusFlush();
+    valid = true;
+
+    // Old path: clear(), then setCursor() + text per row
+    uint32_t fullLcdBytes = 1;
+    for (int row = 0; row < LCD_ROWS; row++) fullLcdBytes += 1 + textLen[row];
+
+    uint32_t bytes = lcdBusWireBytes() - wire0;
+    stat.refreshes++;
+    stat.lastBytes = bytes;
+    if (bytes > stat.maxBytes) stat.maxBytes = bytes;
+    stat.lastFullBytes = fullLcdBytes * kLibraryBytesPerLcdByte;
+    stat.totalBytes += bytes;
+    stat.totalFullBytes += stat.lastFullBytes;
+    stat.lastFlushUs = (uint32_t)(esp_timer_get_time() - t0);
+    return bytes;
+}
+
+void lcdShadowInvalidate() {
+    valid = false;
+    glyphValid = 0;
+    cursorRow = cursorCol = kNoCursor;
+}
+
+void lcdShadowSnapshot(LcdShadowStat& dst) {
+    dst = stat;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file lcd_shadow.h
+ * @brief LCD Shadow - Off-screen 16×2 text buffer with minimal-diff updates
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The LCD task renders each row into a back buffer (lcdShadowPrintf) and
+ * hands the frame over with lcdShadowFlush(). The back buffer is compared
+ * with a copy of what the panel shows, and only the changed character runs
+ * are sent through the LCD bus (lcd_bus.h), as one write burst per
+ * flush: one setCursor() per run, skipped when the panel's address
+ * counter already points there. Two runs separated by a single unchanged
+ * cell are merged (rewriting the cell costs the same as a setCursor()).
+ *
+ * The eight CGRAM glyphs are shadowed the same way: lcdShadowGlyph()
+ * stages a definition and the flush uploads only the glyphs whose rows
+ * changed, before the characters. Glyph slot n is shown by character
+ * code n + 8 (LCD_GLYPH_CHAR), which unlike code 0 fits in a C string.
+ *
+ * The panel is never cleared after boot, so there is no blank frame
+ * between updates (no flicker) and no 2 ms clear() delay.
+ *
+ * I2C bytes sent per refresh are counted by the bus, together with what
+ * the old clear() + rewrite of both rows through LiquidCrystal_I2C would
+ * have sent for the same text (12 wire bytes per LCD byte).
+ *
+ * @note Single writer: only the LCD task draws and flushes
+ * @note Served as JSON by GET /lcd
+ */
+
+#ifndef LCD_SHADOW_H
+#define LCD_SHADOW_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief I2C traffic counters (copied out by lcdShadowSnapshot)
+ */
+struct LcdShadowStat {
+    uint32_t refreshes;         ///< lcdShadowFlush() calls
+    uint32_t chars;             ///< Characters written
+    uint32_t cursorMoves;       ///< setCursor() commands
+    uint32_t glyphUploads;      ///< CGRAM glyph definitions sent
+    uint32_t lastBytes;         ///< I2C bytes sent by the last refresh
+    uint32_t maxBytes;
+    uint32_t lastFullBytes;     ///< Same refresh as clear() + both rows rewritten
+    uint64_t totalBytes;
+    uint64_t totalFullBytes;
+    uint32_t lastFlushUs;       ///< Time spent in the last lcdShadowFlush()
+};
+
+/// Character code showing CGRAM glyph slot n (0-7)
+#define LCD_GLYPH_CHAR(n) ((char)(8 + (n)))
+
+/**
+ * @brief Start from a blank panel
+ * @note Call after lcd.init() and lcd.clear(); later writes must go
+ *       through the shadow (or be followed by lcdShadowInvalidate)
+ */
+void lcdShadowInit();
+
+/**
+ * @brief Format one row into the back buffer
+ * @details Truncated to LCD_COLS characters and padded with spaces
+ */
+void lcdShadowPrintf(uint8_t row, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Stage a custom glyph definition
+ * @param slot 0-7
+ * @param rows 8 rows of 5 pixels, bit 4 = leftmost column
+ */
+void lcdShadowGlyph(uint8_t slot, const uint8_t rows[8]);
+
+/**
+ * @brief Send the changed glyphs and character runs to the panel
+ * @return I2C bytes sent (0 when nothing changed)
+ * @note Caller owns the I2C bus (PM_LOCK_I2C)
+ */
+uint32_t lcdShadowFlush();
+
+/**
+ * @brief Panel content unknown (written around the shadow): the next
+ *        flush rewrites every cell
+ */
+void lcdShadowInvalidate();
+
+/**
+ * @brief Copy the traffic counters
+ */
+void lcdShadowSnapshot(LcdShadowStat& dst);
+
+#endif // LCD_SHADOW_H
@@ -0,0 +1,416 @@
+/**
+ * @file neo_compositor.cpp
+ * @brief NeoPixel Compositor - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The RMT driver uses the legacy IDF 4.x API (driver/rmt.h): IDF 5 aborts
+ * at boot when it is mixed with the new driver that Arduino core 3.x and
+ * Adafruit_NeoPixel use, so there the ADAFRUIT driver is built instead.
+ */
+
+#include "neo_compositor.h"
+#include "neo_effects.h"
+#include "hardware_manager.h"
+#include "../tasks/power_manager.h"
+#include "esp_timer.h"
+#include "esp_freertos_hooks.h"
+#include "esp_idf_version.h"
+#include <time.h>
+
+#if NEO_DRIVER == NEO_DRIVER_RMT && ESP_IDF_VERSION_MAJOR < 5
+  #define NEO_USE_RMT 1
+  #include "driver/rmt.h"
+#else
+  #define NEO_USE_RMT 0
+  #if NEO_DRIVER == NEO_DRIVER_RMT
+    #warning "NEO_DRIVER_RMT needs the legacy RMT driver (IDF 4.x); using Adafruit_NeoPixel::show()"
+  #endif
+#endif
+
+/* ====== Local State ====== */
+
+namespace {
+    uint32_t humFrame[NEOPIXEL_HUM_NUM];
+    uint32_t humShown[NEOPIXEL_HUM_NUM];
+    uint32_t humOut[NEOPIXEL_HUM_NUM];
+    uint32_t uiFrame[NEOPIXEL_UI_NUM];
+    uint32_t uiShown[NEOPIXEL_UI_NUM];
+    uint32_t uiOut[NEOPIXEL_UI_NUM];
+
+    constexpr int64_t kTickUs = portTICK_PERIOD_MS * 1000;
+
+    /**
+     * @brief One strip: driver, frame being rendered, last transmitted frame
+     */
+    struct NeoStrip {
+        Adafruit_NeoPixel& strip;
+        uint32_t* frame;
+        uint32_t* shown;
+        uint32_t* out;           ///< frame[] through the output table, as transmitted
+        uint32_t shownGen;       ///< Output table generation of the last push
+        NeoStripStat stat;
+        volatile bool busy;      ///< Transfer in flight
+        int64_t startUs;         ///< Start of the transfer in flight
+        uint32_t openSeq;        ///< Sequence number of the transfer in flight, 0 = sent by show()
+        uint32_t rmtSent;        ///< RMT transfers started (sequence of the last one)
+        uint32_t rmtEnded;       ///< TX-end callbacks received (sequence of the last one)
+        // Interrupt-off probe (written by the tick hook of probeCore)
+        volatile int64_t probeArmUs;   ///< 0 = not probing
+        volatile int32_t probeLateUs;  ///< -1 = no tick due yet
+        int probeCore;
+        int64_t renderStartUs;   ///< neoRenderBegin() time
+        uint32_t renderPushed;   ///< pushed count at neoRenderBegin()
+    };
+
+    NeoStrip strips[NEO_STRIP_COUNT] = {
+        { stripHum, humFrame, humShown, humOut, 0, { "hum", NEOPIXEL_HUM_NUM } },
+        { stripUI,  uiFrame,  uiShown,  uiOut,  0, { "ui",  NEOPIXEL_UI_NUM } },
+    };
+
+    volatile int64_t lastTickUs[portNUM_PROCESSORS];
+    portMUX_TYPE busyMux = portMUX_INITIALIZER_UNLOCKED;  ///< Closes each transfer exactly once
+
+    // Output stage: gamma * brightness. Rebuilt and read only by renderer
+    // tasks inside neoPresent(), under brightMux; the web only posts the
+    // settings and levelRequested
+    constexpr neo_detail::GammaTable kGamma = neo_detail::makeGamma(NEO_GAMMA);
+    uint8_t outLut[256];
+    uint32_t lutGen = 0;              ///< Bumped per rebuild, 0 = never built
+    volatile uint8_t level = 0;
+    int64_t nextCheckUs = 0;
+    bool levelRequested = false;      ///< Settings changed, apply at the next neoPresent()
+    portMUX_TYPE brightMux = portMUX_INITIALIZER_UNLOCKED;
+    NeoBrightness bright = {
+        NEO_BRIGHTNESS_DAY, NEO_BRIGHTNESS_NIGHT, NEO_NIGHT_START_MIN, NEO_NIGHT_END_MIN, true, 0
+    };
+
+    int localMinute(int16_t tzMin) {
+        time_t now = time(nullptr);
+        if (now < 1600000000) return -1;  // Clock never set (boots at 1970)
+        int32_t m = (int32_t)((now / 60 + tzMin) % 1440);
+        return m < 0 ? m + 1440 : m;
+    }
+
+    uint8_t targetLevel(const NeoBrightness& b) {
+        int m = b.schedule ? localMinute(b.tzMin) : -1;
+        if (m < 0) return b.day;
+        bool night = b.nightStartMin <= b.nightEndMin
+                   ? m >= b.nightStartMin && m < b.nightEndMin
+                   : m >= b.nightStartMin || m < b.nightEndMin;
+        return night ? b.night : b.day;
+    }
+
+    /**
+     * @brief Rebuild the output table for a new level
+     * @details Strips sent with an older generation become stale
+     */
+    void applyLevel(uint8_t target) {
+        portENTER_CRITICAL(&brightMux);
+        if (lutGen == 0 || target != level) {
+            for (int v = 0; v < 256; v++) outLut[v] = (uint8_t)((kGamma.v[v] * (target + 1u)) >> 8);
+            level = target;
+            lutGen++;
+        }
+        portEXIT_CRITICAL(&brightMux);
+    }
+
+    /**
+     * @brief Apply new settings, and follow the schedule (every NEO_SCHEDULE_CHECK_MS)
+     */
+    void brightnessTick() {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&brightMux);
+        bool due = levelRequested || now >= nextCheckUs;
+        if (due) {
+            levelRequested = false;
+            nextCheckUs = now + NEO_SCHEDULE_CHECK_MS * 1000LL;
+        }
+        NeoBrightness b = bright;
+        portEXIT_CRITICAL(&brightMux);
+        if (due) applyLevel(targetLevel(b));
+    }
+
+    /**
+     * @brief One lookup per channel
+     */
+    inline uint32_t mapColor(const uint8_t* lut, uint32_t c) {
+        return ((uint32_t)lut[(c >> 16) & 0xFF] << 16) | ((uint32_t)lut[(c >> 8) & 0xFF] << 8) | lut[c & 0xFF];
+    }
+
+    /**
+     * @brief Map the frame through the output table into out[]
+     * @return Generation of the table used
+     */
+    uint32_t mapFrame(NeoStrip& s) {
+        portENTER_CRITICAL(&brightMux);
+        for (uint16_t i = 0; i < s.stat.pixels; i++) s.out[i] = mapColor(outLut, s.frame[i]);
+        uint32_t gen = lutGen;
+        portEXIT_CRITICAL(&brightMux);
+        return gen;
+    }
+
+    /**
+     * @brief Lateness of the tick interrupt for strips being transmitted
+     * @details A tick is counted when it was due after the transfer began
+     */
+    void IRAM_ATTR onProbeTick() {
+        int core = xPortGetCoreID();
+        int64_t now = esp_timer_get_time();
+        int64_t due = lastTickUs[core] + kTickUs;
+        for (int i = 0; i < NEO_STRIP_COUNT; i++) {
+            NeoStrip& s = strips[i];
+            if (s.probeArmUs == 0 || s.probeCore != core || due < s.probeArmUs) continue;
+            int32_t late = now > due ? (int32_t)(now - due) : 0;
+            if (late > s.probeLateUs) s.probeLateUs = late;
+        }
+        lastTickUs[core] = now;
+    }
+
+    void probeStart(NeoStrip& s) {
+        s.probeCore = xPortGetCoreID();
+        s.probeLateUs = -1;
+        s.probeArmUs = esp_timer_get_time();
+    }
+
+    /**
+     * @brief Close a finished transfer: probe window, wire time, PM lock
+     * @param seq Sequence number of the transfer that ended
+     * @details Called by whichever path sees the end first (TX-end
+     *          interrupt or the task that waited for it). Does nothing
+     *          unless seq is the transfer in flight: the other path finds
+     *          it closed, and a callback arriving after the next transfer
+     *          started does not close that one
+     */
+    void transferDone(NeoStrip& s, uint32_t seq) {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL_SAFE(&busyMux);
+        bool open = s.busy && s.openSeq == seq;
+        if (open) {
+            s.probeArmUs = 0;
+            int32_t late = s.probeLateUs;
+            if (late >= 0) {
+                s.stat.probed++;
+                s.stat.lastIrqOffUs = late;
+                if ((uint32_t)late > s.stat.maxIrqOffUs) s.stat.maxIrqOffUs = late;
+            }
+            s.stat.lastWireUs = (uint32_t)(now - s.startUs);
+            s.busy = false;
+        }
+        portEXIT_CRITICAL_SAFE(&busyMux);
+        if (open) pmRelease(PM_LOCK_NEOPIXEL);
+    }
+
+#if NEO_USE_RMT
+    // 80 MHz APB / 2 = 25 ns per RMT tick, WS2812B bit timings
+    constexpr uint8_t kRmtClkDiv = 2;
+    constexpr uint16_t kT0H = 16, kT0L = 34;   // 0: 0.40 µs high, 0.85 µs low
+    constexpr uint16_t kT1H = 32, kT1L = 18;   // 1: 0.80 µs high, 0.45 µs low
+    constexpr int kSymbolsPerPixel = 24;
+
+    rmt_item32_t humItems[NEOPIXEL_HUM_NUM * kSymbolsPerPixel];
+    rmt_item32_t uiItems[NEOPIXEL_UI_NUM * kSymbolsPerPixel];
+
+    /**
+     * @brief RMT output of a strip (indexed by NeoStripId)
+     */
+    const struct {
+        rmt_channel_t channel;
+        uint8_t pin;
+        rmt_item32_t* items;
+    } kRmtTable[NEO_STRIP_COUNT] = {
+        { (rmt_channel_t)NEO_RMT_CH_HUM, NEOPIXEL_HUM_PIN, humItems },
+        { (rmt_channel_t)NEO_RMT_CH_UI,  NEOPIXEL_UI_PIN,  uiItems },
+    };
+
+    bool rmtReady[NEO_STRIP_COUNT];
+
+    /**
+     * @brief Encode a mapped frame (0xRRGGBB) as GRB, MSB first
+     */
+    void encodeFrame(const uint32_t* frame, uint16_t n, rmt_item32_t* out) {
+        for (uint16_t i = 0; i < n; i++) {
+            uint32_t c = frame[i];
+            uint32_t grb = ((c & 0x00FF00) << 8) | ((c & 0xFF0000) >> 8) | (c & 0xFF);
+            for (uint32_t bit = 1u << 23; bit; bit >>= 1, out++) {
+                bool one = grb & bit;
+                out->level0 = 1;
+                out->duration0 = one ? kT1H : kT0H;
+                out->level1 = 0;
+                out->duration1 = one ? kT1L : kT0L;
+            }
+        }
+    }
+
+    /**
+     * @brief TX-end interrupt: the frame is on the LEDs
+     * @details The driver gives one callback per rmt_write_items(), in
+     *          order, but the waiting task may already have been released
+     *          (tx_sem is given first): counting callbacks recovers the
+     *          sequence number of the transfer this one belongs to
+     */
+    void onRmtTxEnd(rmt_channel_t channel, void* arg) {
+        for (int i = 0; i < NEO_STRIP_COUNT; i++) {
+            if (kRmtTable[i].channel == channel) transferDone(strips[i], ++strips[i].rmtEnded);
+        }
+    }
+
+    bool rmtInstall(int i) {
+        rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX((gpio_num_t)kRmtTable[i].pin, kRmtTable[i].channel);
+        cfg.clk_div = kRmtClkDiv;
+        return rmt_config(&cfg) == ESP_OK && rmt_driver_install(cfg.channel, 0, 0) == ESP_OK;
+    }
+#endif // NEO_USE_RMT
+
+    /**
+     * @brief Send the frame; returns once the driver no longer needs the caller
+     */
+    void transmit(NeoStripId id) {
+        NeoStrip& s = strips[id];
+        s.shownGen = mapFrame(s);
+        pmAcquire(PM_LOCK_NEOPIXEL);
+        s.busy = true;
+        s.startUs = esp_timer_get_time();
+        probeStart(s);
+#if NEO_USE_RMT
+        if (rmtReady[id]) {
+            encodeFrame(s.out, s.stat.pixels, kRmtTable[id].items);
+            s.openSeq = s.rmtSent + 1;  // Set first: the callback may run before write returns
+            if (rmt_write_items(kRmtTable[id].channel, kRmtTable[id].items,
+                                s.stat.pixels * kSymbolsPerPixel, false) == ESP_OK) {
+                s.rmtSent++;
+                return;                 // Closed by onRmtTxEnd or neoWaitIdle
+            }
+        }
+#endif
+        s.openSeq = 0;                  // No callback can match a show() transfer
+        for (uint16_t i = 0; i < s.stat.pixels; i++) s.strip.setPixelColor(i, s.out[i]);
+        s.strip.show();
+        transferDone(s, 0);
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void neoCompositorInit() {
+    applyLevel(targetLevel(bright));
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        esp_register_freertos_tick_hook_for_cpu(onProbeTick, core);
+    }
+
+#if NEO_USE_RMT
+    bool ok = true;
+    for (int i = 0; i < NEO_STRIP_COUNT; i++) {
+        rmtReady[i] = rmtInstall(i);
+        ok = ok && rmtReady[i];
+    }
+    rmt_register_tx_end_callback(onRmtTxEnd, nullptr);
+    Serial.printf("[NEO] %s RMT driver on channels %d/%d\n", ok ? "✓" : "✗ (fallback to show())",
+                  NEO_RMT_CH_HUM, NEO_RMT_CH_UI);
+#else
+    Serial.println("[NEO] Adafruit_NeoPixel driver (show() blocks until sent)");
+#endif
+}
+
+const char* neoDriverName() {
+    return NEO_USE_RMT ? "rmt" : "adafruit";
+}
+
+uint32_t* neoFrame(NeoStripId id) {
+    return strips[id].frame;
+}
+
+uint16_t neoStripPixels(NeoStripId id) {
+    return strips[id].stat.pixels;
+}
+
+void neoRenderBegin(NeoStripId id) {
+    NeoStrip& s = strips[id];
+    s.renderPushed = s.stat.pushed;
+    s.renderStartUs = esp_timer_get_time();
+}
+
+void neoRenderEnd(NeoStripId id) {
+    NeoStrip& s = strips[id];
+    uint32_t us = (uint32_t)(esp_timer_get_time() - s.renderStartUs);
+    if (s.stat.pushed != s.renderPushed) us -= min(us, s.stat.lastBlockUs);
+    s.stat.lastRenderUs = us;
+    if (us > s.stat.maxRenderUs) s.stat.maxRenderUs = us;
+}
+
+bool neoStale(NeoStripId id) {
+    const NeoStrip& s = strips[id];
+    if (s.stat.pushed == 0) return false;
+    portENTER_CRITICAL(&brightMux);
+    bool requested = levelRequested;
+    uint32_t gen = lutGen;
+    portEXIT_CRITICAL(&brightMux);
+    return requested || s.shownGen != gen;
+}
+
+void neoSetBrightness(const NeoBrightness& cfg) {
+    portENTER_CRITICAL(&brightMux);
+    bright = cfg;
+    levelRequested = true;
+    portEXIT_CRITICAL(&brightMux);
+}
+
+NeoBrightness neoGetBrightness() {
+    portENTER_CRITICAL(&brightMux);
+    NeoBrightness b = bright;
+    portEXIT_CRITICAL(&brightMux);
+    return b;
+}
+
+uint8_t neoBrightnessLevel() {
+    return level;
+}
+
+uint8_t neoBrightnessTarget() {
+    return targetLevel(neoGetBrightness());
+}
+
+int neoLocalMinute() {
+    return localMinute(neoGetBrightness().tzMin);
+}
+
+bool neoWaitIdle(NeoStripId id, uint32_t timeoutMs) {
+#if NEO_USE_RMT
+    // The TX-end callback may still be pending on the other core after
+    // the wait returns: close the transfer here so the frame is not dropped.
+    // The late callback then carries an older sequence number and is ignored
+    NeoStrip& s = strips[id];
+    if (s.busy && rmtReady[id] &&
+        rmt_wait_tx_done(kRmtTable[id].channel, pdMS_TO_TICKS(timeoutMs)) == ESP_OK) {
+        transferDone(s, s.openSeq);
+    }
+#endif
+    return !strips[id].busy;
+}
+
+bool neoPresent(NeoStripId id) {
+    NeoStrip& s = strips[id];
+    s.stat.rendered++;
+    brightnessTick();
+
+    size_t bytes = s.stat.pixels * sizeof(uint32_t);
+    if (s.stat.pushed > 0 && s.shownGen == lutGen && memcmp(s.frame, s.shown, bytes) == 0) return false;
+
+    int64_t t0 = esp_timer_get_time();
+    if (!neoWaitIdle(id, 10)) return false;   // Previous frame stuck: retry next frame
+    transmit(id);
+    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+
+    memcpy(s.shown, s.frame, bytes);
+    s.stat.pushed++;
+    s.stat.lastBlockUs = us;
+    if (us > s.stat.maxBlockUs) s.stat.maxBlockUs = us;
+    return true;
+}
+
+int neoStripSnapshot(NeoStripStat* dst, int max) {
+    int n = 0;
+    for (; n < NEO_STRIP_COUNT && n < max; n++) dst[n] = strips[n].stat;
+    return n;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file neo_compositor.h
+ * @brief NeoPixel Compositor - Frame buffers with dirty tracking per strip
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Renderers draw into a strip's frame buffer (neoFrame, neo_effects.h) and hand
+ * it over with neoPresent(). The frame is compared with the last frame
+ * that was transmitted; only a changed frame is sent, under the NeoPixel
+ * PM lock, by one of two drivers (NEO_DRIVER):
+ * - RMT: the frame is encoded into RMT symbols (24 per pixel) and
+ *   neoPresent() returns once the transfer has started. The TX-end
+ *   interrupt marks the strip idle and releases the PM lock; the next
+ *   frame waits for the transfer (neoWaitIdle), which closes it itself
+ *   when the interrupt has not run yet
+ * - ADAFRUIT: copied into the Adafruit_NeoPixel buffer and sent with
+ *   show(), which returns after ~30 µs per pixel
+ *
+ * On the way out every channel passes one lookup table: compile-time
+ * gamma (NEO_GAMMA) scaled by the global brightness. The brightness is
+ * set from the web (GET/POST /brightness) and follows a day/night
+ * schedule, evaluated every NEO_SCHEDULE_CHECK_MS inside neoPresent().
+ * The web only posts new settings; the next neoPresent() (a renderer
+ * task) rebuilds the table, and every strip sent through an older table
+ * is stale (neoStale), so the unchanged frames are sent again.
+ *
+ * Per strip, rendered frames (neoPresent calls) and pushed frames
+ * (transmissions) are counted; in steady state (UI OFF, BAR with a stable
+ * humidity, an unchanged humidity pixel) pushes stay at zero.
+ *
+ * Interrupt-off time is measured with the FreeRTOS tick: while a frame
+ * is being transmitted, a tick hook on the sending core records how late
+ * the tick interrupt was taken. A tick that falls into a window with
+ * interrupts masked is delayed until they are enabled again, so the
+ * maximum delay bounds the interrupt-off time of that driver (ticks are
+ * 1 ms apart, so short frames are only probed now and then).
+ *
+ * @note Each strip must have a single renderer task
+ * @note Served as JSON by GET /neopixel
+ */
+
+#ifndef NEO_COMPOSITOR_H
+#define NEO_COMPOSITOR_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief Strips managed by the compositor
+ */
+enum NeoStripId : uint8_t {
+    NEO_STRIP_HUM = 0,   ///< Humidity pixel (stripHum)
+    NEO_STRIP_UI,        ///< UI bar (stripUI)
+    NEO_STRIP_COUNT
+};
+
+/**
+ * @brief Counters for one strip (copied out by neoStripSnapshot)
+ */
+struct NeoStripStat {
+    const char* name;
+    uint16_t pixels;
+    uint32_t rendered;      ///< Frames presented
+    uint32_t pushed;        ///< Frames transmitted (changed)
+    uint32_t lastBlockUs;   ///< Time neoPresent() held the caller for the last push
+    uint32_t maxBlockUs;
+    uint32_t lastWireUs;    ///< Start of the last push to the end of its transfer
+    uint32_t probed;        ///< Pushes during which a tick was due
+    uint32_t lastIrqOffUs;  ///< Tick delay of the last probed push
+    uint32_t maxIrqOffUs;
+    uint32_t lastRenderUs;  ///< Last neoRenderBegin/End span minus its transmit time
+    uint32_t maxRenderUs;
+};
+
+/**
+ * @brief Name of the driver selected at build time ("rmt" or "adafruit")
+ */
+const char* neoDriverName();
+
+/**
+ * @brief Global brightness settings
+ */
+struct NeoBrightness {
+    uint8_t day;              ///< Level outside the night window, or always without schedule
+    uint8_t night;            ///< Level inside the night window
+    uint16_t nightStartMin;   ///< Local minute of day the night window opens
+    uint16_t nightEndMin;     ///< ... and closes (may wrap past midnight)
+    bool schedule;            ///< Follow the day/night window
+    int16_t tzMin;            ///< Local time offset from UTC in minutes
+};
+
+/**
+ * @brief Pack an RGB color (same layout as Adafruit_NeoPixel::Color)
+ */
+constexpr uint32_t neoColor(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+/**
+ * @brief Install the output driver and the interrupt-off probe
+ * @note Call once at boot, after initHardware() and powerInit()
+ */
+void neoCompositorInit();
+
+/**
+ * @brief Frame buffer of a strip (neoStripPixels() entries)
+ */
+uint32_t* neoFrame(NeoStripId id);
+
+/**
+ * @brief Number of pixels of a strip
+ */
+uint16_t neoStripPixels(NeoStripId id);
+
+/**
+ * @brief Transmit the frame if it differs from the last transmitted one
+ * @return true when a transmission was started
+ * @note The first frame of each strip is always transmitted
+ * @note With the RMT driver the frame buffer may be redrawn right away:
+ *       the transfer reads its own encoded copy
+ */
+bool neoPresent(NeoStripId id);
+
+/**
+ * @brief Bracket the rendering of one frame (LED service) to record its
+ *        render time; a neoPresent() inside the span is not counted
+ */
+void neoRenderBegin(NeoStripId id);
+void neoRenderEnd(NeoStripId id);
+
+/**
+ * @brief Strip has a transmitted frame that is out of date (brightness
+ *        changed); neoPresent() will send it again
+ */
+bool neoStale(NeoStripId id);
+
+/**
+ * @brief Replace the brightness settings
+ * @note Applied by the next neoPresent() of any strip, not by the caller
+ */
+void neoSetBrightness(const NeoBrightness& cfg);
+
+/**
+ * @brief Current brightness settings
+ */
+NeoBrightness neoGetBrightness();
+
+/**
+ * @brief Level applied to the output table (0-255)
+ */
+uint8_t neoBrightnessLevel();
+
+/**
+ * @brief Level the current settings select (0-255); differs from
+ *        neoBrightnessLevel() until the next neoPresent() applies it
+ */
+uint8_t neoBrightnessTarget();
+
+/**
+ * @brief Local minute of day from the system clock, -1 when it is not set
+ */
+int neoLocalMinute();
+
+/**
+ * @brief Wait for the strip's transfer to complete
+ * @return false on timeout
+ */
+bool neoWaitIdle(NeoStripId id, uint32_t timeoutMs);
+
+/**
+ * @brief Copy the counters of every strip
+ * @return Number of strips copied
+ */
+int neoStripSnapshot(NeoStripStat* dst, int max);
+
+#endif // NEO_COMPOSITOR_H
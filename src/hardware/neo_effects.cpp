@@ -0,0 +1,70 @@
+/**
+ * @file neo_effects.cpp
+ * @brief NeoPixel Effects - Render benchmark
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "neo_effects.h"
+#include "../config/config.h"
+#include <Arduino.h>
+
+#if NEO_RENDER_BENCH
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint16_t kBenchLengths[] = { 4, 8, 16, 30, 60, 120, 300 };
+    constexpr uint16_t kBenchMaxLeds = 300;
+    constexpr int kBenchFrames = 64;
+
+    uint32_t benchFrame[kBenchMaxLeds];
+    volatile uint32_t benchSink;       ///< Keeps the rendered frames alive
+
+    /**
+     * @brief Original DEMO renderer: three float sin() calls per pixel
+     */
+    void renderFloat(uint32_t* frame, uint16_t n, uint32_t hue) {
+        for (uint16_t i = 0; i < n; i++) {
+            uint8_t r = (uint8_t)((sin((hue + i * 40) * 0.02f) + 1) * 127);
+            uint8_t g = (uint8_t)((sin((hue + i * 40) * 0.02f + 2.1f) + 1) * 127);
+            uint8_t b = (uint8_t)((sin((hue + i * 40) * 0.02f + 4.2f) + 1) * 127);
+            frame[i] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+        }
+    }
+} // namespace
+
+/* ====== Benchmark ====== */
+
+void neoRenderBench() {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    Serial.printf("\n[NEO] ===== DEMO render cost per frame (%d frames each) =====\n", kBenchFrames);
+    Serial.println("[NEO]  LEDs    float sin()           LUT fixed-point       speedup");
+
+    for (uint16_t n : kBenchLengths) {
+        uint32_t c0 = ESP.getCycleCount();
+        for (int f = 0; f < kBenchFrames; f++) {
+            renderFloat(benchFrame, n, f * 12);
+            benchSink = benchFrame[n - 1];
+        }
+        uint32_t floatCycles = (ESP.getCycleCount() - c0) / kBenchFrames;
+
+        c0 = ESP.getCycleCount();
+        for (int f = 0; f < kBenchFrames; f++) {
+            neoFxRainbow(benchFrame, n, (uint16_t)(f * NEO_DEMO_STEP), NEO_DEMO_SPACING);
+            benchSink = benchFrame[n - 1];
+        }
+        uint32_t lutCycles = (ESP.getCycleCount() - c0) / kBenchFrames;
+
+        Serial.printf("[NEO] %5u  %8u cyc %7.1f us  %8u cyc %7.1f us  %6.1fx\n", n,
+                      (unsigned)floatCycles, (float)floatCycles / mhz,
+                      (unsigned)lutCycles, (float)lutCycles / mhz,
+                      lutCycles ? (float)floatCycles / lutCycles : 0.0f);
+    }
+}
+
+#else
+
+void neoRenderBench() {}
+
+#endif // NEO_RENDER_BENCH
@@ -0,0 +1,189 @@
+/**
+ * @file neo_effects.h
+ * @brief NeoPixel Effects - Compile-time sine/hue tables and fixed-point effects
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Every effect renders into a compositor frame (see neo_compositor.h)
+ * with integer math only:
+ * - kNeoSin8: 256-step sine, (sin + 1) * 127, generated by the compiler
+ * - kNeoHue:  256-entry rainbow (three sines 120° apart), packed RGB
+ * - Phases are 8.8 fixed point: the high byte indexes the tables
+ * - makeGamma(): 256-entry gamma table for the output stage (the
+ *   compositor instantiates it with NEO_GAMMA)
+ *
+ * A DEMO frame costs one table load per pixel instead of three float
+ * sin() calls, so the cost stays linear and small for long strips
+ * (NEO_RENDER_BENCH prints cycles per frame for 4-300 LEDs).
+ *
+ * @note Depends on <stdint.h> only, so it also compiles for a host build
+ */
+
+#ifndef NEO_EFFECTS_H
+#define NEO_EFFECTS_H
+
+#include <stdint.h>
+
+/* ====== Compile-Time Tables ====== */
+
+namespace neo_detail {
+    constexpr double kPi = 3.14159265358979323846;
+
+    /**
+     * @brief Taylor series sine for the table generator (x in [-pi, pi])
+     */
+    constexpr double sinTaylor(double x) {
+        double term = x;
+        double sum = x;
+        for (int k = 1; k < 12; k++) {
+            term *= -x * x / ((2.0 * k) * (2.0 * k + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+
+    struct Sin8Table { uint8_t v[256]; };
+    struct HueTable { uint32_t v[256]; };
+
+    constexpr Sin8Table makeSin8() {
+        Sin8Table t{};
+        for (int i = 0; i < 256; i++) {
+            double x = 2.0 * kPi * i / 256.0;
+            if (x > kPi) x -= 2.0 * kPi;
+            t.v[i] = (uint8_t)((sinTaylor(x) + 1.0) * 127.0 + 0.5);
+        }
+        return t;
+    }
+
+    constexpr Sin8Table kSin8 = makeSin8();
+
+    constexpr HueTable makeHue() {
+        HueTable t{};
+        for (int i = 0; i < 256; i++) {
+            uint32_t r = kSin8.v[i];
+            uint32_t g = kSin8.v[(i + 85) & 0xFF];    // +120°
+            uint32_t b = kSin8.v[(i + 171) & 0xFF];   // +240°
+            t.v[i] = (r << 16) | (g << 8) | b;
+        }
+        return t;
+    }
+    constexpr double kLn2 = 0.69314718055994531;
+
+    /**
+     * @brief Natural log for the table generator (x > 0)
+     * @details Reduced to [1, 2) by powers of two, then the atanh series
+     */
+    constexpr double lnSeries(double x) {
+        int k = 0;
+        while (x >= 2.0) { x /= 2.0; k++; }
+        while (x < 1.0) { x *= 2.0; k--; }
+        double z = (x - 1.0) / (x + 1.0);
+        double term = z;
+        double sum = 0.0;
+        for (int n = 1; n < 40; n += 2) {
+            sum += term / n;
+            term *= z * z;
+        }
+        return 2.0 * sum + k * kLn2;
+    }
+
+    /**
+     * @brief e^y for the table generator (y <= 0)
+     * @details Halved into [-0.5, 0], Taylor series, then squared back
+     */
+    constexpr double expSeries(double y) {
+        int k = 0;
+        while (y < -0.5) { y /= 2.0; k++; }
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 20; n++) {
+            term *= y / n;
+            sum += term;
+        }
+        for (int i = 0; i < k; i++) sum *= sum;
+        return sum;
+    }
+
+    struct GammaTable { uint8_t v[256]; };
+
+    /**
+     * @brief 255 * (i / 255)^gamma, rounded
+     */
+    constexpr GammaTable makeGamma(double gamma) {
+        GammaTable t{};
+        for (int i = 1; i < 256; i++) {
+            t.v[i] = (uint8_t)(255.0 * expSeries(gamma * lnSeries(i / 255.0)) + 0.5);
+        }
+        return t;
+    }
+} // namespace neo_detail
+
+constexpr neo_detail::HueTable kNeoHue = neo_detail::makeHue();
+
+static_assert(neo_detail::kSin8.v[0] == 127 && neo_detail::kSin8.v[64] == 254 && neo_detail::kSin8.v[192] == 0,
+              "sine table generator is off");
+static_assert(neo_detail::makeGamma(2.0).v[128] == 64 && neo_detail::makeGamma(2.0).v[255] == 255,
+              "gamma table generator is off");
+
+/* ====== Fixed-Point Helpers ====== */
+
+/**
+ * @brief Sine of an 8-bit angle (256 = full turn), 0..254
+ */
+constexpr uint8_t neoSin8(uint8_t theta) {
+    return neo_detail::kSin8.v[theta];
+}
+
+/**
+ * @brief Rainbow color of an 8-bit hue
+ */
+constexpr uint32_t neoHue(uint8_t hue) {
+    return kNeoHue.v[hue];
+}
+
+/**
+ * @brief Scale every channel of a packed color by level/256 (255 ≈ unchanged)
+ */
+constexpr uint32_t neoScale(uint32_t color, uint8_t level) {
+    uint32_t k = (uint32_t)level + 1;
+    return ((((color >> 16) & 0xFF) * k >> 8) << 16) |
+           ((((color >> 8) & 0xFF) * k >> 8) << 8) |
+           ((color & 0xFF) * k >> 8);
+}
+
+/* ====== Effects ====== */
+
+/**
+ * @brief Fill the frame with one color
+ */
+inline void neoFxFill(uint32_t* frame, uint16_t n, uint32_t color) {
+    for (uint16_t i = 0; i < n; i++) frame[i] = color;
+}
+
+/**
+ * @brief Rainbow: pixel i shows hue (phase + i * spacing), both 8.8 fixed point
+ */
+inline void neoFxRainbow(uint32_t* frame, uint16_t n, uint16_t phase, uint16_t spacing) {
+    uint16_t p = phase;
+    for (uint16_t i = 0; i < n; i++) {
+        frame[i] = kNeoHue.v[p >> 8];
+        p += spacing;
+    }
+}
+
+/**
+ * @brief Bar graph: (pct10 * n / 1000) + 1 pixels lit, none at 0
+ * @param pct10 Value in 0.1 % steps (0..1000)
+ * @details Same thresholds as the original 4-pixel bar (25/50/75 %)
+ */
+inline void neoFxBar(uint32_t* frame, uint16_t n, uint16_t pct10, uint32_t color) {
+    uint32_t lit = pct10 == 0 ? 0 : (uint32_t)pct10 * n / 1000 + 1;
+    for (uint16_t i = 0; i < n; i++) frame[i] = i < lit ? color : 0;
+}
+
+/**
+ * @brief Print render cost per frame for 4-300 LEDs (NEO_RENDER_BENCH)
+ */
+void neoRenderBench();
+
+#endif // NEO_EFFECTS_H
@@ -0,0 +1,68 @@
+/**
+ * @file neo_pattern.cpp
+ * @brief NeoPixel Patterns - Uploaded pattern storage and parser
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "neo_pattern.h"
+
+/* ====== Local State ====== */
+
+namespace {
+    NeoKeyframe customKeys[NEO_PATTERN_MAX_KEYS];
+    uint8_t customCount = 0;
+    volatile uint32_t generation = 0;
+    portMUX_TYPE patternMux = portMUX_INITIALIZER_UNLOCKED;
+
+    /**
+     * @brief Parse "ms:RRGGBB,..." into keys
+     * @return Number of keyframes, -1 on a syntax or range error
+     */
+    int parse(const char* spec, NeoKeyframe* keys) {
+        int n = 0;
+        const char* p = spec;
+        while (*p) {
+            if (n == NEO_PATTERN_MAX_KEYS) return -1;
+            char* end;
+            unsigned long ms = strtoul(p, &end, 10);
+            if (end == p || *end != ':' || ms == 0 || ms > 60000) return -1;
+            p = end + 1;
+            unsigned long color = strtoul(p, &end, 16);
+            if (end - p != 6) return -1;
+            keys[n++] = { (uint16_t)ms, (uint32_t)color };
+            p = end;
+            if (*p == ',') p++;
+            else if (*p) return -1;
+        }
+        return n > 0 ? n : -1;
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+int neoPatternUpload(const char* spec) {
+    NeoKeyframe keys[NEO_PATTERN_MAX_KEYS];
+    int n = parse(spec, keys);
+    if (n < 0) return -1;
+
+    portENTER_CRITICAL(&patternMux);
+    memcpy(customKeys, keys, n * sizeof(NeoKeyframe));
+    customCount = (uint8_t)n;
+    generation++;
+    portEXIT_CRITICAL(&patternMux);
+    return n;
+}
+
+uint32_t neoPatternCustom(NeoKeyframe* dst, uint8_t& count) {
+    portENTER_CRITICAL(&patternMux);
+    memcpy(dst, customKeys, customCount * sizeof(NeoKeyframe));
+    count = customCount;
+    uint32_t gen = generation;
+    portEXIT_CRITICAL(&patternMux);
+    return gen;
+}
+
+uint32_t neoPatternGeneration() {
+    return generation;
+}
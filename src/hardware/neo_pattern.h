@@ -0,0 +1,124 @@
+/**
+ * @file neo_pattern.h
+ * @brief NeoPixel Patterns - Declarative keyframe tables on a monotonic clock
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * A pattern is a looping list of keyframes, each holding one color on the
+ * whole strip for a number of milliseconds. neoPatternAt() maps the time
+ * since the pattern started (esp_timer) to the current color and the time
+ * left until the next keyframe, so the UI task can sleep exactly that
+ * long; late wake-ups never shift the pattern.
+ *
+ * Built-in patterns are constexpr tables (kNeoSos, kNeoBlink). One more
+ * pattern can be uploaded at runtime (POST /ui/pattern, UI mode 5) as
+ * "ms:RRGGBB,ms:RRGGBB,...".
+ */
+
+#ifndef NEO_PATTERN_H
+#define NEO_PATTERN_H
+
+#include "neo_compositor.h"
+
+/**
+ * @brief One step of a pattern: color held for ms
+ */
+struct NeoKeyframe {
+    uint16_t ms;
+    uint32_t color;
+};
+
+/**
+ * @brief Looping keyframe list
+ */
+struct NeoPattern {
+    const NeoKeyframe* keys;
+    uint8_t count;
+};
+
+/**
+ * @brief Color now and time until it changes
+ */
+struct NeoPatternPos {
+    uint32_t color;
+    uint32_t nextMs;        ///< Rounded up: waking then lands on the keyframe
+};
+
+/**
+ * @brief Length of one loop of the pattern
+ */
+constexpr uint32_t neoPatternPeriodMs(const NeoPattern& p) {
+    uint32_t ms = 0;
+    for (uint8_t i = 0; i < p.count; i++) ms += p.keys[i].ms;
+    return ms;
+}
+
+/**
+ * @brief Evaluate a pattern at elapsedUs after its start
+ */
+constexpr NeoPatternPos neoPatternAt(const NeoPattern& p, int64_t elapsedUs) {
+    int64_t periodUs = (int64_t)neoPatternPeriodMs(p) * 1000;
+    if (periodUs == 0) return { 0, 0 };
+    int64_t phase = elapsedUs > 0 ? elapsedUs % periodUs : 0;
+    for (uint8_t i = 0; i < p.count; i++) {
+        int64_t keyUs = (int64_t)p.keys[i].ms * 1000;
+        if (phase < keyUs) return { p.keys[i].color, (uint32_t)((keyUs - phase + 999) / 1000) };
+        phase -= keyUs;
+    }
+    return { p.keys[0].color, p.keys[0].ms };
+}
+
+/* ====== Built-In Patterns ====== */
+
+namespace neo_detail {
+    constexpr uint16_t kU = NEO_SOS_UNIT_MS;
+    constexpr uint32_t kSosOn = neoColor(255, 0, 0);
+    constexpr uint32_t kBlinkOn = neoColor(255, 100, 0);
+
+    constexpr NeoKeyframe kSosKeys[] = {
+        { 1 * kU, kSosOn }, { 1 * kU, 0 }, { 1 * kU, kSosOn }, { 1 * kU, 0 }, { 1 * kU, kSosOn }, { 3 * kU, 0 },
+        { 3 * kU, kSosOn }, { 1 * kU, 0 }, { 3 * kU, kSosOn }, { 1 * kU, 0 }, { 3 * kU, kSosOn }, { 3 * kU, 0 },
+        { 1 * kU, kSosOn }, { 1 * kU, 0 }, { 1 * kU, kSosOn }, { 1 * kU, 0 }, { 1 * kU, kSosOn }, { 7 * kU, 0 },
+    };
+
+    constexpr NeoKeyframe kBlinkKeys[] = {
+        { NEO_BLINK_HALF_MS, kBlinkOn }, { NEO_BLINK_HALF_MS, 0 },
+    };
+} // namespace neo_detail
+
+/// ··· ─── ··· in red, Morse timing
+constexpr NeoPattern kNeoSos = {
+    neo_detail::kSosKeys, sizeof(neo_detail::kSosKeys) / sizeof(neo_detail::kSosKeys[0])
+};
+
+/// Orange warning blink
+constexpr NeoPattern kNeoBlink = {
+    neo_detail::kBlinkKeys, sizeof(neo_detail::kBlinkKeys) / sizeof(neo_detail::kBlinkKeys[0])
+};
+
+static_assert(neoPatternPeriodMs(kNeoSos) == 34 * NEO_SOS_UNIT_MS, "SOS is 34 Morse units");
+static_assert(neoPatternAt(kNeoSos, 0).color == neo_detail::kSosOn &&
+              neoPatternAt(kNeoSos, 0).nextMs == NEO_SOS_UNIT_MS, "SOS starts with a dot");
+
+/* ====== Uploaded Pattern ====== */
+
+/**
+ * @brief Replace the uploaded pattern
+ * @param spec "ms:RRGGBB" keyframes separated by commas, 1-60000 ms each
+ * @return Number of keyframes, or -1 when spec is invalid (pattern unchanged)
+ */
+int neoPatternUpload(const char* spec);
+
+/**
+ * @brief Copy the uploaded pattern (NEO_PATTERN_MAX_KEYS entries)
+ * @param count Number of keyframes copied (0 = none uploaded)
+ * @return Upload generation (changes with every successful upload)
+ */
+uint32_t neoPatternCustom(NeoKeyframe* dst, uint8_t& count);
+
+/**
+ * @brief Upload generation, to skip the copy when nothing changed
+ */
+uint32_t neoPatternGeneration();
+
+#endif // NEO_PATTERN_H
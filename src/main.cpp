@@ -62,6 +62,7 @@
 // Configuration and types
 #include "config/config.h"          // Hardware pins, timing constants
 #include "config/system_types.h"    // Data structures, enums, global state
+#include "config/config_store.h"    // Persistent thresholds / WiFi (NVS)
 
 // Hardware management
 #include "hardware/hardware_manager.h"  // Device initialization, semaphores
@@ -72,6 +73,14 @@
 // Web server
 #include "web/web_server.h"         // HTTP server, WiFi management
 
+// Machine learning
+#include "ml/model_store.h"         // Anomaly model persistence (LittleFS)
+
+// Diagnostics
+#include "tasks/trace_recorder.h"   // Binary event trace (GET /trace)
+#include "tasks/power_manager.h"    // DFS / light sleep (POWER_MGMT_ENABLED)
+#include "hardware/neo_compositor.h" // NeoPixel output driver
+
 /**
  * @brief System initialization (runs once at boot)
  * @details Performs sequential initialization in the correct order:
@@ -107,12 +116,27 @@ void setup() {
     Serial.println("=== System Initialization ===");
     initHardware();
     
+    // Mount LittleFS so the TinyML task can load an uploaded model
+    initModelStore();
+    
+    // Load thresholds and WiFi settings from NVS (defaults if none/invalid)
+    configInit();
+    
     // Step 3: Initialize FreeRTOS synchronization primitives
     // Creates three binary semaphores for inter-task communication
     initSemaphores();
     
-    // Step 4: Initialize WiFi in Access Point mode
-    // Creates "ESP32-S3-LAB" network with IP 192.168.4.1
+    // Start the event trace recorder (tick hooks) before any task runs
+    traceInit();
+    
+    // Configure DFS / light sleep and create the PM locks (POWER_MGMT_ENABLED)
+    powerInit();
+    
+    // NeoPixel output driver (RMT channels) - takes the NeoPixel PM lock per frame
+    neoCompositorInit();
+    
+    // Step 4: Initialize WiFi (stored Station network, else Access Point)
+    // AP creates "ESP32-S3-LAB" network with IP 192.168.4.1
     initWiFi();
     
     // Step 5: Initialize web server and register HTTP routes
@@ -142,7 +166,7 @@ void setup() {
  * 
  * Loop Behavior:
  * - Calls handleWebServer() to process one HTTP request (non-blocking)
- * - Delays 2ms to prevent watchdog timer issues
+ * - Delays HTTP_POLL_MS (2ms, 20ms with power management) to prevent watchdog timer issues
  * - Repeats indefinitely
  * 
  * @note This function is called automatically by Arduino framework
@@ -152,11 +176,16 @@ void setup() {
  * @warning Do not remove delay (may trigger watchdog timer)
  * 
  * CPU Usage:
- * - loop() runs on PRO_CPU core (core 0)
- * - FreeRTOS tasks run on APP_CPU core (core 1) or both (tskNO_AFFINITY)
- * - Web server is not thread-safe, so must run on PRO_CPU
+ * - loop() runs on ARDUINO_RUNNING_CORE (core 1 on the YOLO Uno)
+ * - FreeRTOS tasks run where TASK_PLACEMENT_PROFILE puts them
+ * - Web server is not thread-safe; with a split/packed profile it moves
+ *   to the WEB task and loop() only idles
  */
 void loop() {
+#if TASK_WEB_IN_TASK
+    // HTTP requests are served by the WEB task (placement profile)
+    delay(1000);
+#else
     // Process incoming HTTP client requests
     // Non-blocking: returns immediately if no request pending
     handleWebServer();
@@ -165,5 +194,6 @@ void loop() {
     // 1. Prevent watchdog timer timeout
     // 2. Yield CPU time to FreeRTOS tasks
     // 3. Reduce power consumption slightly
-    delay(2);  // 2ms delay = ~500 iterations per second
+    delay(HTTP_POLL_MS);  // 2ms = ~500 iterations per second (20ms with power management)
+#endif
 }
@@ -0,0 +1,121 @@
+/**
+ * @file dht_anomaly_kernel.h
+ * @brief Hand-specialized evaluator for the DHT anomaly MLP
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The anomaly model is tiny (2 → 8 → 1 dense network), so the TFLM
+ * interpreter's per-op dispatch dominates the actual arithmetic. This header
+ * evaluates the same network directly from constexpr weights that
+ * tools/gen_anomaly_kernel.py extracts from the flatbuffer at build time.
+ *
+ * Network:
+ *   hidden = ReLU(W1 · [tC, rh] + B1)     (8 neurons)
+ *   score  = sigmoid(W2 · hidden + B2)    (1 output)
+ *
+ * Dot products use ESP-DSP (SIMD on ESP32-S3) when the library is available
+ * and fall back to plain scalar C++ elsewhere, so the header also compiles
+ * on a host toolchain.
+ *
+ * @note Enabled with -D TINYML_FAST_KERNEL=1 (see config.h)
+ * @warning Only valid for the compiled-in dht_anomaly_model_tflite;
+ *          regenerate dht_anomaly_weights.h whenever the model changes
+ */
+
+#ifndef DHT_ANOMALY_KERNEL_H
+#define DHT_ANOMALY_KERNEL_H
+
+#include <math.h>
+#include "dht_anomaly_weights.h"
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && __has_include("dsps_dotprod.h")
+  #include "dsps_dotprod.h"
+  #define DHT_KERNEL_USE_DSP 1
+#else
+  #define DHT_KERNEL_USE_DSP 0
+#endif
+
+namespace dht_anomaly_kernel {
+
+/**
+ * @brief Fixed-length scalar dot product
+ * @tparam N Vector length (compile-time, loop fully unrolled by the compiler)
+ */
+template <int N>
+inline float dotScalar(const float* a, const float* b) {
+    float acc = 0.0f;
+    for (int i = 0; i < N; i++) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+/**
+ * @brief Fixed-length dot product, ESP-DSP accelerated when available
+ * @tparam N Vector length
+ * @note Very short vectors stay scalar - the library call costs more than the math
+ */
+template <int N>
+inline float dot(const float* a, const float* b) {
+#if DHT_KERNEL_USE_DSP
+    if (N >= 4) {
+        float out = 0.0f;
+        dsps_dotprod_f32(a, b, &out, N);
+        return out;
+    }
+#endif
+    return dotScalar<N>(a, b);
+}
+
+/**
+ * @brief Fixed-size two-layer MLP (Dense+ReLU → Dense → sigmoid)
+ * @tparam IN  Number of inputs
+ * @tparam HID Hidden layer width
+ */
+template <int IN, int HID>
+struct DenseMlp {
+    const float* w1;  ///< [HID][IN] row-major
+    const float* b1;  ///< [HID]
+    const float* w2;  ///< [HID]
+    float b2;         ///< Output bias
+
+    /**
+     * @brief Run one forward pass
+     * @param x Input vector (IN floats)
+     * @return Sigmoid output in range 0.0-1.0
+     */
+    inline float eval(const float* x) const {
+        alignas(16) float hidden[HID];
+        for (int j = 0; j < HID; j++) {
+            float v = dot<IN>(&w1[j * IN], x) + b1[j];
+            hidden[j] = v > 0.0f ? v : 0.0f;  // Fused ReLU
+        }
+        float logit = dot<HID>(w2, hidden) + b2;
+        return 1.0f / (1.0f + expf(-logit));
+    }
+};
+
+/**
+ * @brief Evaluator bound to the compiled-in anomaly model weights
+ */
+constexpr DenseMlp<dht_anomaly_weights::kInputs, dht_anomaly_weights::kHidden> kModel = {
+    dht_anomaly_weights::kW1,
+    dht_anomaly_weights::kB1,
+    dht_anomaly_weights::kW2,
+    dht_anomaly_weights::kB2,
+};
+
+/**
+ * @brief Compute the anomaly score without the TFLM interpreter
+ * @param tC Temperature in Celsius
+ * @param rh Relative humidity in %
+ * @return Anomaly score (0.0 = normal, 1.0 = anomalous)
+ */
+inline float anomalyScore(float tC, float rh) {
+    alignas(16) const float x[dht_anomaly_weights::kInputs] = { tC, rh };
+    return kModel.eval(x);
+}
+
+} // namespace dht_anomaly_kernel
+
+#endif // DHT_ANOMALY_KERNEL_H
@@ -0,0 +1,44 @@
+/**
+ * @file dht_anomaly_weights.h
+ * @brief Dense-layer weights extracted from dht_anomaly_model_tflite
+ * @note Auto-generated by tools/gen_anomaly_kernel.py - do not edit.
+ *       Regenerated on every build when TINYML_FAST_KERNEL is enabled.
+ *
+ * Layer 1: FULLY_CONNECTED 2 -> 8, fused ReLU
+ * Layer 2: FULLY_CONNECTED 8 -> 1, followed by LOGISTIC
+ */
+
+#ifndef DHT_ANOMALY_WEIGHTS_H
+#define DHT_ANOMALY_WEIGHTS_H
+
+namespace dht_anomaly_weights {
+
+constexpr int kInputs = 2;   ///< Model inputs (temperature, humidity)
+constexpr int kHidden = 8;   ///< Hidden layer width
+
+/** @brief Layer 1 weights, row-major [kHidden][kInputs] */
+alignas(16) constexpr float kW1[kHidden * kInputs] = {
+    5.593720675e-01f, -7.728442550e-01f, -2.287418842e-01f, 6.875795126e-01f,
+    7.139264792e-02f, 3.016732633e-01f, 5.515077710e-01f, -1.916755438e-01f,
+    2.960700989e-01f, -3.130713701e-01f, -3.620814383e-01f, 7.015937567e-01f,
+    -2.352645397e-01f, 4.562366009e-02f, 6.516188979e-01f, -3.474202752e-01f
+};
+
+/** @brief Layer 1 bias [kHidden] */
+alignas(16) constexpr float kB1[kHidden] = {
+    0.000000000e+00f, 6.750873476e-02f, -6.589683890e-02f, 4.876380041e-02f,
+    0.000000000e+00f, -6.537600607e-02f, 0.000000000e+00f, 3.548118100e-02f
+};
+
+/** @brief Layer 2 weights [kHidden] */
+alignas(16) constexpr float kW2[kHidden] = {
+    -4.780237377e-01f, 8.417665958e-01f, -7.065519691e-01f, -3.001818359e-01f,
+    -6.164025068e-01f, -4.739387333e-01f, -3.393316269e-02f, 1.801144145e-02f
+};
+
+/** @brief Layer 2 bias */
+constexpr float kB2 = 6.671705097e-02f;
+
+} // namespace dht_anomaly_weights
+
+#endif // DHT_ANOMALY_WEIGHTS_H
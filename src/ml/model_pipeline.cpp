@@ -0,0 +1,293 @@
+/**
+ * @file model_pipeline.cpp
+ * @brief Model Pipeline - Shared-arena registry implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Only one interpreter exists at a time. It is placement-constructed in
+ * interpreterStorage on top of sharedArena, used for one model, then
+ * destroyed so the next model can reuse the same memory.
+ */
+
+#include "model_pipeline.h"
+#include <new>
+#include "esp_timer.h"
+#include "tinyml.h"
+#include "dht_anomaly_kernel.h"
+
+#if __has_include("comfort_model.h")
+  #include "comfort_model.h"          // const unsigned char comfort_model_tflite[]
+  #define PIPE_HAS_COMFORT 1
+#else
+  #define PIPE_HAS_COMFORT 0
+#endif
+
+#if __has_include("forecast_model.h")
+  #include "forecast_model.h"         // const unsigned char forecast_model_tflite[]
+  #define PIPE_HAS_FORECAST 1
+#else
+  #define PIPE_HAS_FORECAST 0
+#endif
+
+/* ====== Local State ====== */
+
+namespace
+{
+    tflite::MicroErrorReporter reporter;    ///< Logs TFLM errors to Serial
+    tflite::AllOpsResolver resolver;        ///< Shared by every model
+
+    /**
+     * @brief The single tensor arena shared by all models
+     */
+    alignas(16) uint8_t sharedArena[TINYML_ARENA_SIZE];
+
+    /**
+     * @brief Storage for the one interpreter bound to sharedArena
+     */
+    alignas(tflite::MicroInterpreter) uint8_t interpreterStorage[sizeof(tflite::MicroInterpreter)];
+    tflite::MicroInterpreter *bound = nullptr;
+} // namespace
+
+const uint32_t kPipelineArenaSize = TINYML_ARENA_SIZE;
+uint32_t gPipelinePlannedBytes = 0;
+
+/**
+ * @brief Registry - signatures are fixed, flatbuffers are installed at runtime
+ */
+PipelineModel gPipeline[PIPE_COUNT] = {
+    { "anomaly",  nullptr, 0, 2, 1, 0.0f, 1.0f },         // [tC, rh] → [score]
+    { "comfort",  nullptr, 0, 2, 3, 0.0f, 1.0f },         // [tC, rh] → [cold, comfortable, warm]
+    { "forecast", nullptr, 0, 2, 1, -100.0f, 150.0f },    // [tC, rh] → [tC in TINYML_INFERENCE_MS]
+};
+
+/* ====== Helper Functions ====== */
+
+/**
+ * @brief Interpreter-free evaluator for the compiled-in anomaly model
+ */
+static float anomalyFast(const float *in)
+{
+    return dht_anomaly_kernel::anomalyScore(in[0], in[1]);
+}
+
+/**
+ * @brief Structural checks that do not need the arena
+ * @details Flatbuffer verifier, schema version, operator availability
+ */
+static bool validateFlatbuffer(const uint8_t *data, size_t len, const char *&reason)
+{
+    flatbuffers::Verifier verifier(data, len);
+    if (!tflite::VerifyModelBuffer(verifier))
+    {
+        reason = "invalid flatbuffer";
+        return false;
+    }
+
+    const tflite::Model *model = tflite::GetModel(data);
+    if (model->version() != TFLITE_SCHEMA_VERSION)
+    {
+        reporter.Report("Model provided is schema version %d, not equal to supported version %d.",
+                        model->version(), TFLITE_SCHEMA_VERSION);
+        reason = "schema version mismatch";
+        return false;
+    }
+
+    auto *opcodes = model->operator_codes();
+    for (size_t i = 0; opcodes != nullptr && i < opcodes->size(); i++)
+    {
+#if __has_include("tensorflow/lite/schema/schema_utils.h")
+        tflite::BuiltinOperator code = tflite::GetBuiltinCode(opcodes->Get(i));
+#else
+        tflite::BuiltinOperator code = opcodes->Get(i)->builtin_code();
+#endif
+        if (code == tflite::BuiltinOperator_CUSTOM || resolver.FindOp(code) == nullptr)
+        {
+            reason = "unsupported operator";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Recompute the shared arena plan from the ready models
+ */
+static void replan()
+{
+    gPipelinePlannedBytes = 0;
+    for (int i = 0; i < PIPE_COUNT; i++)
+    {
+        if (gPipeline[i].ready && gPipeline[i].arenaBytes > gPipelinePlannedBytes)
+        {
+            gPipelinePlannedBytes = gPipeline[i].arenaBytes;
+        }
+    }
+}
+
+/* ====== Binding ====== */
+
+tflite::MicroInterpreter *pipelineBind(const PipelineModel &m, const char *&reason)
+{
+    pipelineUnbind();
+    if (m.data == nullptr)
+    {
+        reason = "not installed";
+        return nullptr;
+    }
+
+    bound = new (interpreterStorage) tflite::MicroInterpreter(
+        tflite::GetModel(m.data), resolver, sharedArena, TINYML_ARENA_SIZE, &reporter);
+    if (bound->AllocateTensors() != kTfLiteOk)
+    {
+        reason = "arena too small";
+        pipelineUnbind();
+        return nullptr;
+    }
+
+    TfLiteTensor *in = bound->input(0);
+    TfLiteTensor *out = bound->output(0);
+    if (in == nullptr || out == nullptr ||
+        in->type != kTfLiteFloat32 || in->bytes != m.inputs * sizeof(float) ||
+        out->type != kTfLiteFloat32 || out->bytes != m.outputs * sizeof(float))
+    {
+        reason = "tensor signature mismatch";
+        pipelineUnbind();
+        return nullptr;
+    }
+    return bound;
+}
+
+void pipelineUnbind()
+{
+    if (bound != nullptr)
+    {
+        bound->~MicroInterpreter();
+        bound = nullptr;
+    }
+}
+
+/* ====== Registry ====== */
+
+bool pipelineSetModel(int index, const uint8_t *data, size_t len, bool builtin, const char *&reason)
+{
+    PipelineModel &entry = gPipeline[index];
+    if (entry.outputs > TINYML_MAX_OUTPUTS)
+    {
+        reason = "too many outputs";
+        return false;
+    }
+    if (!validateFlatbuffer(data, len, reason)) return false;
+
+    // Bind the candidate in the shared arena (free between runs) and probe it
+    PipelineModel candidate = entry;
+    candidate.data = data;
+    candidate.len = len;
+    tflite::MicroInterpreter *interp = pipelineBind(candidate, reason);
+    if (interp == nullptr) return false;
+
+    for (int i = 0; i < candidate.inputs; i++)
+    {
+        interp->input(0)->data.f[i] = (i == 0) ? 25.0f : 50.0f;
+    }
+    bool ok = interp->Invoke() == kTfLiteOk;
+    for (int i = 0; ok && i < candidate.outputs; i++)
+    {
+        float v = interp->output(0)->data.f[i];
+        ok = v >= candidate.outMin && v <= candidate.outMax;  // Also rejects NaN
+    }
+    uint32_t used = interp->arena_used_bytes();
+    pipelineUnbind();
+    if (!ok)
+    {
+        reason = "probe inference failed";
+        return false;
+    }
+
+    // Commit - the previous flatbuffer is no longer referenced after this
+    entry.data = data;
+    entry.len = len;
+    entry.builtin = builtin;
+    entry.fast = (TINYML_FAST_KERNEL && index == PIPE_ANOMALY && builtin) ? anomalyFast : nullptr;
+    entry.arenaBytes = used;
+    entry.ready = true;
+    replan();
+    return true;
+}
+
+void pipelineInit()
+{
+    const char *reason = "";
+#if PIPE_HAS_COMFORT
+    if (!pipelineSetModel(PIPE_COMFORT, comfort_model_tflite, sizeof(comfort_model_tflite), true, reason))
+    {
+        Serial.printf("[TinyML] Comfort model rejected (%s)\n", reason);
+    }
+#endif
+#if PIPE_HAS_FORECAST
+    if (!pipelineSetModel(PIPE_FORECAST, forecast_model_tflite, sizeof(forecast_model_tflite), true, reason))
+    {
+        Serial.printf("[TinyML] Forecast model rejected (%s)\n", reason);
+    }
+#endif
+    (void)reason;
+}
+
+/* ====== Schedule ====== */
+
+int pipelineRun(const float *snapshot, int count)
+{
+    int ok = 0;
+    for (int i = 0; i < PIPE_COUNT; i++)
+    {
+        PipelineModel &m = gPipeline[i];
+        if (!m.ready) continue;
+        if (m.inputs > count)
+        {
+            m.errors++;
+            continue;
+        }
+
+        if (m.fast != nullptr)
+        {
+            int64_t t0 = esp_timer_get_time();
+            m.out[0] = m.fast(snapshot);
+            m.invokeUs = (uint32_t)(esp_timer_get_time() - t0);
+            m.bindUs = 0;
+        }
+        else
+        {
+            const char *reason = "";
+            int64_t t0 = esp_timer_get_time();
+            tflite::MicroInterpreter *interp = pipelineBind(m, reason);
+            int64_t t1 = esp_timer_get_time();
+            if (interp == nullptr)
+            {
+                m.errors++;
+                continue;
+            }
+
+            for (int k = 0; k < m.inputs; k++) interp->input(0)->data.f[k] = snapshot[k];
+            bool invoked = interp->Invoke() == kTfLiteOk;
+            int64_t t2 = esp_timer_get_time();
+            if (invoked)
+            {
+                for (int k = 0; k < m.outputs; k++) m.out[k] = interp->output(0)->data.f[k];
+                m.arenaBytes = interp->arena_used_bytes();
+            }
+            pipelineUnbind();
+
+            if (!invoked)
+            {
+                m.errors++;
+                continue;
+            }
+            m.bindUs = (uint32_t)(t1 - t0);
+            m.invokeUs = (uint32_t)(t2 - t1);
+        }
+
+        if (m.invokeUs > m.maxInvokeUs) m.maxInvokeUs = m.invokeUs;
+        m.runs++;
+        ok++;
+    }
+    return ok;
+}
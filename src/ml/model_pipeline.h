@@ -0,0 +1,126 @@
+/**
+ * @file model_pipeline.h
+ * @brief Model Pipeline - Registry of TFLM models sharing one tensor arena
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Several small models run back-to-back on the same input snapshot from the
+ * TinyML task. Because their invocations never overlap, they do not need an
+ * arena each: every model is bound to the single shared arena just before
+ * it runs (interpreter constructed + AllocateTensors) and unbound after.
+ *
+ * Arena Planning:
+ *   pipelineSetModel() binds each model once when it is installed, records
+ *   its arena_used_bytes() high-water mark, and the shared arena requirement
+ *   is the maximum (not the sum) over all ready models.
+ *
+ * Schedule (one pipeline run):
+ *   snapshot = [tC, rh]
+ *   for each ready model in registry order:
+ *       bind → copy inputs → Invoke → copy outputs to out[] → unbind
+ *
+ * Registry (PipelineIndex order):
+ *   0. anomaly  - dht_anomaly_model.h (always present, hot-swappable)
+ *   1. comfort  - comfort_model.h     (comfort classifier, optional)
+ *   2. forecast - forecast_model.h    (short-horizon temperature, optional)
+ *   Optional models are compiled in only when their header exists in src/ml/.
+ */
+
+#ifndef MODEL_PIPELINE_H
+#define MODEL_PIPELINE_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+namespace tflite { class MicroInterpreter; }
+
+/**
+ * @brief Registry positions
+ */
+enum PipelineIndex : uint8_t {
+    PIPE_ANOMALY = 0,   ///< DHT anomaly score (TinyML task publishes gLive.tinyml_score)
+    PIPE_COMFORT,       ///< Comfort classifier
+    PIPE_FORECAST,      ///< Short-horizon temperature forecaster
+    PIPE_COUNT
+};
+
+/**
+ * @brief One registered model and its telemetry
+ */
+struct PipelineModel {
+    const char* name;                     ///< Short name (web API, logs)
+    const uint8_t* data;                  ///< Flatbuffer (flash or RAM), nullptr = not installed
+    size_t len;                           ///< Flatbuffer size in bytes
+    uint8_t inputs;                       ///< Floats taken from the snapshot
+    uint8_t outputs;                      ///< Floats produced
+    float outMin;                         ///< Probe outputs must lie in [outMin, outMax]
+    float outMax;
+    float (*fast)(const float* in);       ///< Interpreter-free evaluator (may be nullptr)
+    bool builtin;                         ///< data is the compiled-in model
+
+    // Telemetry (updated by pipelineRun)
+    bool ready;                           ///< Passed validation, scheduled
+    uint32_t runs;                        ///< Successful invocations
+    uint32_t errors;                      ///< Failed bind/invoke
+    uint32_t bindUs;                      ///< Last bind time (construct + AllocateTensors)
+    uint32_t invokeUs;                    ///< Last invoke time
+    uint32_t maxInvokeUs;                 ///< Worst invoke time
+    uint32_t arenaBytes;                  ///< Arena high-water mark
+    float out[TINYML_MAX_OUTPUTS];        ///< Last outputs
+};
+
+/**
+ * @brief Model registry (PIPE_COUNT entries)
+ */
+extern PipelineModel gPipeline[PIPE_COUNT];
+
+/**
+ * @brief Shared arena size in bytes (TINYML_ARENA_SIZE)
+ */
+extern const uint32_t kPipelineArenaSize;
+
+/**
+ * @brief Planned arena requirement (max high-water mark over ready models)
+ */
+extern uint32_t gPipelinePlannedBytes;
+
+/**
+ * @brief Register the optional models found at build time
+ * @note Called once by the TinyML task; the anomaly model is then
+ *       installed with pipelineSetModel(PIPE_ANOMALY, ...)
+ */
+void pipelineInit();
+
+/**
+ * @brief Run every ready model on one input snapshot
+ * @param snapshot Input floats (models take the first `inputs` values)
+ * @param count Number of snapshot values
+ * @return Number of models that ran successfully
+ */
+int pipelineRun(const float* snapshot, int count);
+
+/**
+ * @brief Validate a new flatbuffer for a registry entry and swap it in
+ * @param index Registry entry
+ * @param data New flatbuffer (must stay valid while in use)
+ * @param len Its size
+ * @param builtin true if data is the compiled-in model
+ * @param[out] reason Short rejection reason on failure
+ * @return true if swapped; on failure the entry keeps its previous model
+ * @note Call only between pipeline runs (from the TinyML task)
+ */
+bool pipelineSetModel(int index, const uint8_t* data, size_t len, bool builtin, const char*& reason);
+
+/**
+ * @brief Bind a model to the shared arena for direct use (benchmarks)
+ * @return Interpreter with tensors allocated, or nullptr (see reason)
+ * @note Call pipelineUnbind() before the next pipeline run
+ */
+tflite::MicroInterpreter* pipelineBind(const PipelineModel& m, const char*& reason);
+
+/**
+ * @brief Release the interpreter bound to the shared arena
+ */
+void pipelineUnbind();
+
+#endif // MODEL_PIPELINE_H
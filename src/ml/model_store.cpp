@@ -0,0 +1,207 @@
+/**
+ * @file model_store.cpp
+ * @brief Model Store - LittleFS persistence and streaming upload
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Upload chunks are written directly to /model.tmp as they arrive, so the
+ * web server never holds the whole flatbuffer in RAM. Only the TinyML task
+ * reads models back into memory (into its standby model buffer).
+ *
+ * File operations from the web loop and the TinyML task are serialized by
+ * a mutex so a rename never races with a read of the same file.
+ */
+
+#include "model_store.h"
+#include <LittleFS.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "../config/config.h"
+
+/* ====== File Names ====== */
+
+static const char* kTmpPath    = "/model.tmp";     ///< Upload in progress
+static const char* kStagedPath = "/model.new";     ///< Waiting for validation
+static const char* kActivePath = "/model.tflite";  ///< Last accepted model
+
+/* ====== Local State ====== */
+
+volatile ModelStoreStatus gModelStore;
+
+static SemaphoreHandle_t storeMutex = NULL;  ///< Serializes file access
+static File uploadFile;                      ///< Open /model.tmp during upload
+static volatile bool stagedPending = false;  ///< /model.new ready for TinyML task
+static uint32_t stagedGen = 0;               ///< Generation of /model.new (bumped per staged upload)
+static volatile bool revertPending = false;  ///< Swap back to compiled-in model
+
+/* ====== Helper Functions ====== */
+
+static void setError(const char* reason) {
+    strlcpy((char*)gModelStore.lastError, reason, sizeof(gModelStore.lastError));
+}
+
+static size_t readFile(const char* path, uint8_t* dst, size_t cap, uint32_t* gen = nullptr) {
+    if (!gModelStore.fsReady) return 0;
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    if (gen) *gen = stagedGen;  // Same lock as the rename: tags exactly the file read
+    size_t n = 0;
+    File f = LittleFS.open(path, "r");
+    if (f) {
+        size_t size = f.size();
+        if (size > 0 && size <= cap) {
+            n = f.read(dst, size);
+            if (n != size) n = 0;  // Short read = unusable model
+        }
+        f.close();
+    }
+    xSemaphoreGive(storeMutex);
+    return n;
+}
+
+/* ====== Initialization ====== */
+
+bool initModelStore() {
+#if STATIC_ALLOCATION
+    static StaticSemaphore_t storeMutexBuffer;
+    storeMutex = xSemaphoreCreateMutexStatic(&storeMutexBuffer);
+#else
+    storeMutex = xSemaphoreCreateMutex();
+#endif
+
+    // Format on first boot so a blank 'spiffs' partition becomes usable
+    if (!LittleFS.begin(true)) {
+        Serial.println("[MODEL] LittleFS mount failed - using compiled-in model only");
+        return false;
+    }
+    gModelStore.fsReady = true;
+
+    // An upload interrupted by reset leaves /model.tmp behind
+    if (LittleFS.exists(kTmpPath)) LittleFS.remove(kTmpPath);
+
+    // A staged model that was never validated gets another chance
+    stagedPending = LittleFS.exists(kStagedPath);
+    if (stagedPending) stagedGen++;
+
+    Serial.printf("[MODEL] Store ready (%u/%u bytes used)\n",
+                  (unsigned)LittleFS.usedBytes(), (unsigned)LittleFS.totalBytes());
+    return true;
+}
+
+/* ====== Upload ====== */
+
+bool modelUploadBegin() {
+    if (!gModelStore.fsReady) return false;
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    if (uploadFile) uploadFile.close();
+    uploadFile = LittleFS.open(kTmpPath, "w");
+    xSemaphoreGive(storeMutex);
+    gModelStore.uploadBytes = 0;
+    return (bool)uploadFile;
+}
+
+bool modelUploadWrite(const uint8_t* data, size_t len) {
+    if (!uploadFile) return false;
+    if (gModelStore.uploadBytes + len > TINYML_MODEL_MAX_BYTES) {
+        setError("model too large");
+        modelUploadAbort();
+        return false;
+    }
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    size_t written = uploadFile.write(data, len);
+    xSemaphoreGive(storeMutex);
+    gModelStore.uploadBytes += written;
+    return written == len;
+}
+
+bool modelUploadEnd() {
+    if (!uploadFile) return false;
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    uploadFile.close();
+    bool ok = gModelStore.uploadBytes > 0;
+    if (ok) {
+        // Only a complete upload replaces a model still waiting for validation
+        if (LittleFS.exists(kStagedPath)) LittleFS.remove(kStagedPath);
+        ok = LittleFS.rename(kTmpPath, kStagedPath);
+        if (ok) {
+            stagedGen++;  // A validation in progress now belongs to an older file
+            stagedPending = true;
+        } else {
+            stagedPending = false;  // The old staged file is gone
+        }
+    }
+    if (!ok) LittleFS.remove(kTmpPath);
+    xSemaphoreGive(storeMutex);
+
+    if (ok) {
+        Serial.printf("[MODEL] Upload staged (%u bytes), waiting for validation\n",
+                      (unsigned)gModelStore.uploadBytes);
+    } else {
+        setError(gModelStore.uploadBytes > 0 ? "staging failed" : "empty upload");
+        Serial.printf("[MODEL] ✗ Upload not staged (%s)\n", (const char*)gModelStore.lastError);
+    }
+    return ok;
+}
+
+void modelUploadAbort() {
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    if (uploadFile) uploadFile.close();
+    if (gModelStore.fsReady) LittleFS.remove(kTmpPath);
+    xSemaphoreGive(storeMutex);
+    Serial.println("[MODEL] Upload aborted");
+}
+
+/* ====== Swap ====== */
+
+bool modelStagedPending() {
+    return stagedPending;
+}
+
+size_t modelLoadStaged(uint8_t* dst, size_t cap, uint32_t& gen) {
+    return readFile(kStagedPath, dst, cap, &gen);
+}
+
+bool modelResolveStaged(uint32_t gen, bool accepted, const char* reason) {
+    xSemaphoreTake(storeMutex, portMAX_DELAY);
+    if (gen != stagedGen) {
+        // Replaced by a newer upload during validation: that file is not
+        // the one checked, leave it staged for the next validation
+        xSemaphoreGive(storeMutex);
+        return false;
+    }
+    if (accepted) {
+        LittleFS.remove(kActivePath);
+        LittleFS.rename(kStagedPath, kActivePath);
+    } else {
+        LittleFS.remove(kStagedPath);
+    }
+    stagedPending = false;
+    xSemaphoreGive(storeMutex);
+
+    if (accepted) {
+        gModelStore.swaps++;
+        setError("");
+    } else {
+        gModelStore.rejects++;
+        setError(reason);
+    }
+    return true;
+}
+
+size_t modelLoadPersisted(uint8_t* dst, size_t cap) {
+    return readFile(kActivePath, dst, cap);
+}
+
+void modelStoreReset() {
+    if (gModelStore.fsReady) {
+        xSemaphoreTake(storeMutex, portMAX_DELAY);
+        LittleFS.remove(kActivePath);
+        xSemaphoreGive(storeMutex);
+    }
+    revertPending = true;
+}
+
+bool modelRevertPending() {
+    bool pending = revertPending;
+    revertPending = false;
+    return pending;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file model_store.h
+ * @brief Model Store - Anomaly model persistence on LittleFS
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Lets the anomaly model be replaced without reflashing the firmware.
+ * A new .tflite flatbuffer is streamed chunk-by-chunk from the HTTP upload
+ * handler straight into flash, then validated and swapped in by the TinyML
+ * task at its next inference boundary.
+ *
+ * Files on LittleFS:
+ * - /model.tmp    : Upload in progress (deleted on abort)
+ * - /model.new    : Complete upload waiting for validation
+ * - /model.tflite : Last model that passed validation (loaded at boot)
+ *
+ * Swap Flow:
+ *   Web (/ml/model) ──upload──> /model.tmp ──rename──> /model.new
+ *   TinyML task ──load + validate──> OK:   /model.new → /model.tflite, swap
+ *                                    FAIL: delete /model.new, keep old model
+ *
+ * Every staged file gets a new generation id. The TinyML task resolves
+ * only the generation it read, so an upload that replaces /model.new
+ * during validation is never renamed to /model.tflite unchecked.
+ *
+ * @note The compiled-in dht_anomaly_model_tflite stays the fallback when no
+ *       stored model exists or the stored one fails validation at boot
+ */
+
+#ifndef MODEL_STORE_H
+#define MODEL_STORE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Model store status (read by web API)
+ */
+struct ModelStoreStatus {
+    bool     fsReady = false;       ///< LittleFS mounted
+    bool     stored = false;        ///< Active model was loaded from LittleFS
+    uint32_t activeBytes = 0;       ///< Size of the active model
+    uint32_t uploadBytes = 0;       ///< Bytes received by the last/current upload
+    uint32_t swaps = 0;             ///< Successful hot swaps
+    uint32_t rejects = 0;           ///< Models that failed validation
+    char     lastError[48] = "";    ///< Reason of last rejection (empty if none)
+};
+
+/**
+ * @brief Global model store status
+ */
+extern volatile ModelStoreStatus gModelStore;
+
+/**
+ * @brief Mount LittleFS and discard any interrupted upload
+ * @return true if the filesystem is usable
+ * @note Call once during setup() before creating tasks
+ */
+bool initModelStore();
+
+/* ====== Upload (called from web server loop) ====== */
+
+/**
+ * @brief Start a new upload (truncates /model.tmp)
+ * @return false if the filesystem is not available
+ */
+bool modelUploadBegin();
+
+/**
+ * @brief Append one upload chunk to flash
+ * @return false on write error or when TINYML_MODEL_MAX_BYTES is exceeded
+ */
+bool modelUploadWrite(const uint8_t* data, size_t len);
+
+/**
+ * @brief Finish the upload and stage it for validation
+ * @return true if the file was staged (/model.new)
+ */
+bool modelUploadEnd();
+
+/**
+ * @brief Abort the upload and delete the partial file
+ */
+void modelUploadAbort();
+
+/* ====== Swap (called from TinyML task) ====== */
+
+/**
+ * @brief Check whether a staged model is waiting for validation
+ */
+bool modelStagedPending();
+
+/**
+ * @brief Read the staged model into a RAM buffer
+ * @param dst Destination buffer
+ * @param cap Buffer capacity in bytes
+ * @param gen Receives the generation id of the file read
+ * @return Number of bytes read (0 on error or if it does not fit)
+ */
+size_t modelLoadStaged(uint8_t* dst, size_t cap, uint32_t& gen);
+
+/**
+ * @brief Resolve the staged model after validation
+ * @param gen Generation returned by modelLoadStaged()
+ * @param accepted true = persist as /model.tflite, false = delete it
+ * @param reason Rejection reason recorded in gModelStore.lastError
+ * @return false if a newer upload replaced the file meanwhile (it stays
+ *         staged and nothing is renamed or deleted)
+ */
+bool modelResolveStaged(uint32_t gen, bool accepted, const char* reason = "");
+
+/**
+ * @brief Read the persisted model (/model.tflite) into a RAM buffer
+ * @return Number of bytes read (0 if no stored model)
+ */
+size_t modelLoadPersisted(uint8_t* dst, size_t cap);
+
+/**
+ * @brief Delete the persisted model and request a swap back to the compiled-in model
+ */
+void modelStoreReset();
+
+/**
+ * @brief Check (and clear) a pending revert to the compiled-in model
+ */
+bool modelRevertPending();
+
+#endif // MODEL_STORE_H
@@ -0,0 +1,72 @@
+/**
+ * @file stat_anomaly.cpp
+ * @brief Streaming Statistical Anomaly Detector - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "stat_anomaly.h"
+#include "../config/config.h"
+
+StatAnomaly gStat;
+
+/* ====== Helper Functions ====== */
+
+/**
+ * @brief Update one channel and return its normalized deviation
+ * @param c Channel state
+ * @param x New sample
+ * @param minStd Noise floor (sensor resolution) so a flat signal does not explode z
+ * @return max(|z| / STAT_Z_ALARM, CUSUM / STAT_CUSUM_H), or -1 during warm-up
+ */
+static float updateChannel(StatChannel& c, float x, float minStd) {
+    // Welford: numerically stable running mean/variance
+    c.n++;
+    float delta = x - c.mean;
+    c.mean += delta / c.n;
+    c.m2 += delta * (x - c.mean);
+
+    if (c.n <= STAT_WARMUP_SAMPLES) {
+        // Seed the short-term baseline from the long-term one
+        c.ewmaMean = c.mean;
+        c.ewmaVar = c.n > 1 ? c.m2 / (c.n - 1) : 0.0f;
+        return -1.0f;
+    }
+
+    // z-score against the baseline *before* this sample is absorbed
+    float var = c.ewmaVar > minStd * minStd ? c.ewmaVar : minStd * minStd;
+    c.z = (x - c.ewmaMean) / sqrtf(var);
+
+    // EWMA mean/variance (West's incremental form)
+    float diff = x - c.ewmaMean;
+    float incr = STAT_EWMA_ALPHA * diff;
+    c.ewmaMean += incr;
+    c.ewmaVar = (1.0f - STAT_EWMA_ALPHA) * (c.ewmaVar + diff * incr);
+
+    // Two-sided CUSUM on the standardized sample, z clipped so a single
+    // spike (already caught by the z term) does not latch the drift alarm
+    float zc = fminf(fmaxf(c.z, -STAT_Z_ALARM), STAT_Z_ALARM);
+    c.cusumPos = fmaxf(0.0f, c.cusumPos + zc - STAT_CUSUM_K);
+    c.cusumNeg = fmaxf(0.0f, c.cusumNeg - zc - STAT_CUSUM_K);
+
+    float zTerm = fabsf(c.z) / STAT_Z_ALARM;
+    float cusumTerm = fmaxf(c.cusumPos, c.cusumNeg) / STAT_CUSUM_H;
+    return fmaxf(zTerm, cusumTerm);
+}
+
+/* ====== Public Functions ====== */
+
+float statAnomalyUpdate(float tC, float rh) {
+    if (isnan(tC) || isnan(rh)) return NAN;
+
+    float mt = updateChannel(gStat.temp, tC, STAT_MIN_STD_TEMP);
+    float mh = updateChannel(gStat.hum, rh, STAT_MIN_STD_HUM);
+    if (mt < 0.0f || mh < 0.0f) return NAN;  // Still warming up
+
+    float m = fmaxf(mt, mh);
+    return m / (1.0f + m);
+}
+
+float statStdDev(const StatChannel& c) {
+    return c.n > 1 ? sqrtf(c.m2 / (c.n - 1)) : 0.0f;
+}
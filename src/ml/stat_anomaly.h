@@ -0,0 +1,71 @@
+/**
+ * @file stat_anomaly.h
+ * @brief Streaming Statistical Anomaly Detector - O(1) per sample baseline
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Lightweight anomaly signal computed inside the sensor task on every
+ * DHT20 reading. It runs alongside the TinyML model and is the fallback
+ * anomaly source when the TensorFlow Lite Micro interpreter is unavailable.
+ *
+ * Per channel (temperature, humidity):
+ * - Welford running mean/variance (long-term baseline since boot)
+ * - EWMA mean/variance (short-term baseline, alpha = STAT_EWMA_ALPHA)
+ * - z-score of each sample against the EWMA baseline
+ * - Two-sided CUSUM on z (detects slow drifts a single z-score misses)
+ *
+ * Score:
+ *   m = max(|z| / STAT_Z_ALARM, CUSUM / STAT_CUSUM_H)  over both channels
+ *   score = m / (1 + m)    → 0.0 normal, 0.5 at alarm threshold, → 1.0
+ *
+ * Cost: a handful of float multiply/adds and one sqrtf per channel,
+ * no buffers and no allocation.
+ */
+
+#ifndef STAT_ANOMALY_H
+#define STAT_ANOMALY_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Streaming statistics for one sensor channel
+ */
+struct StatChannel {
+    uint32_t n = 0;          ///< Samples seen
+    float mean = 0.0f;       ///< Welford running mean
+    float m2 = 0.0f;         ///< Welford sum of squared deviations
+    float ewmaMean = 0.0f;   ///< EWMA mean
+    float ewmaVar = 0.0f;    ///< EWMA variance
+    float cusumPos = 0.0f;   ///< Upper CUSUM statistic
+    float cusumNeg = 0.0f;   ///< Lower CUSUM statistic
+    float z = 0.0f;          ///< Latest z-score against EWMA baseline
+};
+
+/**
+ * @brief Detector state for both channels
+ */
+struct StatAnomaly {
+    StatChannel temp;        ///< Temperature channel (°C)
+    StatChannel hum;         ///< Humidity channel (%)
+};
+
+/**
+ * @brief Global detector state (written by Task 1, read by web server)
+ */
+extern StatAnomaly gStat;
+
+/**
+ * @brief Feed one sensor reading into the detector
+ * @param tC Temperature in Celsius
+ * @param rh Relative humidity in %
+ * @return Anomaly score 0.0-1.0, or NAN during warm-up / on invalid input
+ * @note Called by Task 1 on every DHT20 reading
+ */
+float statAnomalyUpdate(float tC, float rh);
+
+/**
+ * @brief Welford standard deviation of a channel
+ */
+float statStdDev(const StatChannel& c);
+
+#endif // STAT_ANOMALY_H
@@ -55,6 +55,10 @@
  * 5. Replace dht_anomaly_model.h with your model
  * 6. Recompile and upload firmware
  * 
+ * Or, without reflashing (see model_store.h):
+ *   curl -F "model=@model.tflite" http://192.168.4.1/ml/model
+ * The model must keep the 2-float input / 1-float output signature.
+ * 
  * Resources:
  * ==========
  * - TensorFlow Lite Micro: https://www.tensorflow.org/lite/microcontrollers
@@ -111,15 +115,4 @@ void setupTinyML();
  */
 void tiny_ml_task(void *pvParameters);
 
-/**
- * @brief Create TinyML FreeRTOS task
- * @details Wrapper function that creates the TinyML task with:
- *          - Stack: 8192 bytes (large for ML operations)
- *          - Priority: 1 (low - not time-critical)
- *          - Core: tskNO_AFFINITY (auto load-balance)
- * @note Called by createAllTasks() during system initialization
- * @note Task starts running immediately after creation
- */
-void createTinyMLTask();
-
 #endif // __TINY_ML__
@@ -0,0 +1,53 @@
+/**
+ * @file tinyml_bench.h
+ * @brief TinyML Benchmark Harness - Latency, throughput and score regression
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Replays a CSV trace through the same dht_anomaly_model_tflite array that
+ * setupTinyML() uses and reports:
+ * - Invocations per second of the interpreter and of the fast kernel
+ *   (best of TINYML_BENCH_PASSES whole passes, timed per pass)
+ * - Latency percentiles (p50 / p90 / p99 / max, one extra timed pass)
+ * - Score distribution (10 bins over 0.0-1.0)
+ * - Accuracy at score 0.5 when the trace carries labels
+ * - PASS/FAIL against throughput baselines (regression gate)
+ *
+ * Trace Source:
+ * - CSV lines "tC,rh" or "tC,rh,label" (label 0/1), headers skipped
+ * - Otherwise a built-in synthetic trace (diurnal cycle + injected anomalies)
+ *
+ * Runs on the board only ([env:bench_tinyml]) at TinyML task start: trace
+ * from /trace.csv on LittleFS, baselines from TINYML_BENCH_BASELINE_IPS /
+ * TINYML_BENCH_BASELINE_KERNEL_IPS; a failure stops the TinyML task
+ */
+
+#ifndef TINYML_BENCH_H
+#define TINYML_BENCH_H
+
+/**
+ * @brief Measured throughput of one run
+ */
+struct TinyMLBenchResult {
+    int samples = 0;            ///< Trace samples replayed per pass
+    float ips = 0.0f;           ///< Interpreter invocations per second
+    float kernelIps = 0.0f;     ///< Fast kernel evaluations per second (0 = not built)
+};
+
+/**
+ * @brief Run the benchmark once and print the report
+ * @param tracePath CSV trace, synthetic trace when nullptr or missing
+ * @param result Receives the throughput figures
+ * @return false if the model could not be loaded or run
+ */
+bool runTinyMLBench(const char* tracePath, TinyMLBenchResult& result);
+
+/**
+ * @brief Compare one throughput figure with its baseline and print the verdict
+ * @param name Path being gated ("interpreter", "kernel")
+ * @param baselineIps Known-good throughput, <= 0 = no baseline (passes)
+ * @return false when ips is more than TINYML_BENCH_MAX_REGRESSION_PCT below it
+ */
+bool tinymlBenchGate(const char* name, float ips, float baselineIps);
+
+#endif // TINYML_BENCH_H
@@ -0,0 +1,209 @@
+/**
+ * @file deadline_monitor.cpp
+ * @brief Deadline Monitor - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Lateness is measured end-to-start: the tasks sleep a fixed delay after
+ * each activation, so an activation is expected periodMs after the
+ * previous one ended. Lateness is then the scheduling delay alone; the
+ * execution time is checked separately against the budget.
+ */
+
+#include "deadline_monitor.h"
+#include "deferred_log.h"
+#include "../config/system_types.h"
+#include "esp_timer.h"
+#include "esp_task_wdt.h"
+
+const uint32_t kDeadlineBucketUs[kDeadlineBuckets - 1] = {
+    1000, 2000, 5000, 10000, 20000, 50000, 100000
+};
+
+#if DEADLINE_MONITOR_ENABLED
+
+#ifdef CONFIG_ESP_TASK_WDT_TIMEOUT_S
+  #define DL_WDT_TIMEOUT_MS (CONFIG_ESP_TASK_WDT_TIMEOUT_S * 1000)
+#else
+  #define DL_WDT_TIMEOUT_MS 5000
+#endif
+
+/* ====== Local State ====== */
+
+namespace {
+    /**
+     * @brief Declared timing of one periodic task
+     */
+    struct DeadlineSpec {
+        const char* name;
+        uint32_t periodMs;
+        uint32_t budgetUs;
+        uint32_t toleranceMs;
+    };
+
+    constexpr DeadlineSpec kDeadlineTable[DL_COUNT] = {
+        // name     period                  budget                     tolerance
+        { "DHT20",  DHT_READ_INTERVAL_MS,   DEADLINE_DHT_BUDGET_US,    DEADLINE_DHT_TOLERANCE_MS },
+        { "NEO_UI", UI_STRIP_UPDATE_MS,     DEADLINE_NEO_UI_BUDGET_US, DEADLINE_NEO_UI_TOLERANCE_MS },
+        { "TinyML", TINYML_INFERENCE_MS,    DEADLINE_TINYML_BUDGET_US, DEADLINE_TINYML_TOLERANCE_MS },
+    };
+
+    DeadlineStat stats[DL_COUNT];
+    int64_t startUs[DL_COUNT];       ///< Start of the current activation, 0 = none open
+    int64_t prevEndUs[DL_COUNT];     ///< End of the previous activation, 0 = first
+    uint32_t gapMs[DL_COUNT];        ///< Expected gap before the current activation, 0 = period
+    uint32_t nextGapMs[DL_COUNT];    ///< Announced by deadlineNext() for the next one
+    bool wdtWatched[DL_COUNT];       ///< Owning task subscribed to the TWDT
+    TaskHandle_t owner[DL_COUNT];    ///< Task running the activations
+
+    bool anyEscalated() {
+        for (const DeadlineStat& s : stats) {
+            if (s.escalated) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief true when any row run by the same task is escalated
+     * @note In EXECUTOR_MODE several rows share the EXEC task
+     */
+    bool ownerEscalated(TaskHandle_t task) {
+        for (int i = 0; i < DL_COUNT; i++) {
+            if (owner[i] == task && stats[i].escalated) return true;
+        }
+        return false;
+    }
+
+    int bucketFor(uint32_t us) {
+        for (int b = 0; b < kDeadlineBuckets - 1; b++) {
+            if (us < kDeadlineBucketUs[b]) return b;
+        }
+        return kDeadlineBuckets - 1;
+    }
+
+    /**
+     * @brief Update the violation streak and apply DEADLINE_ESCALATION
+     */
+    void escalate(DeadlineId id, bool violated, uint32_t latenessUs, uint32_t execUs) {
+        DeadlineStat& s = stats[id];
+
+        if (!violated) {
+            s.streak = 0;
+            if (s.escalated) {
+                s.escalated = false;
+#if DEADLINE_ESCALATION >= DL_ESCALATE_LOG
+                DLOG_I("[DEADLINE] ✓ %s back on time\n", s.name);
+#endif
+#if DEADLINE_ESCALATION >= DL_ESCALATE_ALERT
+                if (!anyEscalated()) gLive.deadline_alert = 0;
+#endif
+            }
+            return;
+        }
+
+        s.streak++;
+        if (s.escalated || s.streak < DEADLINE_ESCALATE_AFTER) return;
+
+        s.escalated = true;
+        s.escalations++;
+#if DEADLINE_ESCALATION >= DL_ESCALATE_LOG
+        DLOG_W("[DEADLINE] ✗ %s: %u violations in a row (late %u us / tol %u ms, exec %u us / budget %u us)\n",
+               s.name, (unsigned)s.streak, (unsigned)latenessUs, (unsigned)s.toleranceMs,
+               (unsigned)execUs, (unsigned)s.budgetUs);
+#endif
+#if DEADLINE_ESCALATION >= DL_ESCALATE_ALERT
+        gLive.deadline_alert = 1;
+#endif
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void deadlineBegin(DeadlineId id) {
+    int64_t now = esp_timer_get_time();
+    DeadlineStat& s = stats[id];
+
+    if (s.name == nullptr) {
+        // First activation: load the declaration
+        const DeadlineSpec& spec = kDeadlineTable[id];
+        s.name = spec.name;
+        s.periodMs = spec.periodMs;
+        s.budgetUs = spec.budgetUs;
+        s.toleranceMs = spec.toleranceMs;
+        owner[id] = xTaskGetCurrentTaskHandle();
+#if DEADLINE_ESCALATION >= DL_ESCALATE_WDT
+        // Only tasks that run well inside the TWDT timeout can feed it
+        if (spec.periodMs * 2 < DL_WDT_TIMEOUT_MS) {
+            esp_err_t err = esp_task_wdt_add(nullptr);
+            wdtWatched[id] = err == ESP_OK || err == ESP_ERR_INVALID_ARG;  // INVALID_ARG = already subscribed
+        }
+#endif
+    }
+
+    startUs[id] = now;
+}
+
+void deadlineEnd(DeadlineId id) {
+    if (startUs[id] == 0) return;
+    int64_t now = esp_timer_get_time();
+    DeadlineStat& s = stats[id];
+
+    uint32_t execUs = (uint32_t)(now - startUs[id]);
+    uint32_t latenessUs = 0;
+    if (prevEndUs[id] != 0) {
+        uint32_t gap = gapMs[id] ? gapMs[id] : s.periodMs;
+        int64_t late = startUs[id] - prevEndUs[id] - (int64_t)gap * 1000;
+        latenessUs = late > 0 ? (uint32_t)late : 0;
+    }
+    prevEndUs[id] = now;
+    startUs[id] = 0;
+    gapMs[id] = nextGapMs[id];
+    nextGapMs[id] = 0;
+
+    bool missed = latenessUs > s.toleranceMs * 1000;
+    bool overrun = execUs > s.budgetUs;
+
+    s.activations++;
+    s.hist[bucketFor(latenessUs)]++;
+    if (missed) s.misses++;
+    if (overrun) s.overruns++;
+    if (latenessUs > s.maxLatenessUs) s.maxLatenessUs = latenessUs;
+    if (execUs > s.maxExecUs) s.maxExecUs = execUs;
+    s.lastExecUs = execUs;
+
+    escalate(id, missed || overrun, latenessUs, execUs);
+
+    // Starve this task's watchdog while it is escalated
+    if (wdtWatched[id] && !ownerEscalated(owner[id])) esp_task_wdt_reset();
+}
+
+void deadlineNext(DeadlineId id, uint32_t ms) {
+    nextGapMs[id] = ms;
+}
+
+int deadlineSnapshot(DeadlineStat* dst, int max) {
+    int n = 0;
+    for (int i = 0; i < DL_COUNT && n < max; i++) {
+        if (stats[i].name == nullptr) continue;  // Not started yet
+        dst[n++] = stats[i];
+    }
+    return n;
+}
+
+#else
+
+int deadlineSnapshot(DeadlineStat* dst, int max) {
+    return 0;
+}
+
+#endif // DEADLINE_MONITOR_ENABLED
+
+const char* deadlineEscalationName() {
+    if (!DEADLINE_MONITOR_ENABLED) return "off";
+    switch (DEADLINE_ESCALATION) {
+        case DL_ESCALATE_LOG:   return "log";
+        case DL_ESCALATE_ALERT: return "alert";
+        case DL_ESCALATE_WDT:   return "wdt";
+        default:                return "none";
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file deadline_monitor.h
+ * @brief Deadline Monitor - Period misses and budget overruns of periodic tasks
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Every periodic task declares a period, an execution budget and a
+ * lateness tolerance (kDeadlineTable in deadline_monitor.cpp) and brackets
+ * one activation with deadlineBegin()/deadlineEnd(). Per task the monitor
+ * keeps:
+ * - Lateness histogram (start time vs previous end + period)
+ * - Misses (lateness > tolerance) and overruns (execution > budget)
+ * - Worst lateness / execution time
+ *
+ * After DEADLINE_ESCALATE_AFTER consecutive violations the task is
+ * escalated according to DEADLINE_ESCALATION:
+ *   DL_ESCALATE_LOG    serial log on entering/leaving the escalated state
+ *   DL_ESCALATE_ALERT  + gLive.deadline_alert (shown by /state)
+ *   DL_ESCALATE_WDT    + stop feeding the task watchdog, so a task that
+ *                      stays escalated for the TWDT timeout trips it
+ *
+ * @note Each row is written only by the task that owns it; readers (web)
+ *       may see a torn sample, same as gLive
+ * @note Served as JSON by GET /deadlines
+ */
+
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief Monitored periodic tasks (rows of kDeadlineTable)
+ */
+enum DeadlineId : uint8_t {
+    DL_SENSOR = 0,   ///< Task 1: DHT20, DHT_READ_INTERVAL_MS
+    DL_NEO_UI,       ///< Task 4: NeoPixel UI bar, UI_STRIP_UPDATE_MS or next keyframe
+    DL_TINYML,       ///< Task 6: TinyML, TINYML_INFERENCE_MS
+    DL_COUNT
+};
+
+constexpr int kDeadlineBuckets = 8;   ///< Lateness histogram buckets
+
+/**
+ * @brief Upper bound (exclusive) of each lateness bucket in µs; the last
+ *        bucket collects everything above kDeadlineBucketUs[kDeadlineBuckets - 2]
+ */
+extern const uint32_t kDeadlineBucketUs[kDeadlineBuckets - 1];
+
+/**
+ * @brief State and statistics of one monitored task
+ */
+struct DeadlineStat {
+    const char* name;               ///< Task name (matches kTaskTable)
+    uint32_t periodMs;              ///< Declared period
+    uint32_t budgetUs;              ///< Execution budget per activation
+    uint32_t toleranceMs;           ///< Allowed lateness before a miss is counted
+    uint32_t activations;           ///< Completed activations
+    uint32_t misses;                ///< Activations started later than toleranceMs
+    uint32_t overruns;              ///< Activations that exceeded budgetUs
+    uint32_t maxLatenessUs;         ///< Worst lateness
+    uint32_t maxExecUs;             ///< Worst execution time
+    uint32_t lastExecUs;            ///< Last execution time
+    uint32_t streak;                ///< Consecutive violating activations
+    uint32_t escalations;           ///< Times the task entered the escalated state
+    bool escalated;                 ///< streak >= DEADLINE_ESCALATE_AFTER
+    uint32_t hist[kDeadlineBuckets];   ///< Lateness histogram
+};
+
+#if DEADLINE_MONITOR_ENABLED
+/**
+ * @brief Mark the start of an activation (call first thing in the period)
+ */
+void deadlineBegin(DeadlineId id);
+
+/**
+ * @brief Mark the end of an activation (before sleeping until the next one)
+ * @note An activation without a matching deadlineBegin() is ignored
+ */
+void deadlineEnd(DeadlineId id);
+
+/**
+ * @brief Announce that the next activation is due ms after this one
+ *        (instead of the declared period); call before deadlineEnd()
+ */
+void deadlineNext(DeadlineId id, uint32_t ms);
+#else
+inline void deadlineBegin(DeadlineId) {}
+inline void deadlineEnd(DeadlineId) {}
+inline void deadlineNext(DeadlineId, uint32_t) {}
+#endif
+
+/**
+ * @brief Copy the statistics of every monitored task
+ * @param dst Destination array
+ * @param max Capacity of dst
+ * @return Number of rows copied (0 when the monitor is disabled)
+ */
+int deadlineSnapshot(DeadlineStat* dst, int max);
+
+/**
+ * @brief Escalation level name for the web API ("off", "log", "alert", "wdt")
+ */
+const char* deadlineEscalationName();
+
+#endif // DEADLINE_MONITOR_H
@@ -0,0 +1,254 @@
+/**
+ * @file deferred_log.cpp
+ * @brief Deferred Logger - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Ring: bounded MPMC queue with one sequence number per slot. A slot at
+ * position pos is free when seq == pos and holds a record when
+ * seq == pos + 1. Producers claim a position with a CAS on head, fill the
+ * slot and publish it by storing seq; the consumer claims with a CAS on
+ * tail and releases the slot for the next lap (seq = pos + DLOG_QUEUE_LEN).
+ * No producer ever waits for another one or for the LOG task.
+ */
+
+#include "deferred_log.h"
+#include <atomic>
+
+static_assert((DLOG_QUEUE_LEN & (DLOG_QUEUE_LEN - 1)) == 0, "DLOG_QUEUE_LEN must be a power of two");
+static_assert(DLOG_MAX_ARGS <= 8, "argument types are packed into 16 bits");
+
+/* ====== Local State ====== */
+
+namespace {
+    /**
+     * @brief One ring slot
+     */
+    struct DlogSlot {
+        std::atomic<uint32_t> seq;
+        const char* fmt;                   ///< Format ID (string literal)
+        uint8_t level;
+        uint8_t count;                     ///< Arguments used
+        uint16_t types;                    ///< DlogArgType per argument, 2 bits each
+        DlogValue args[DLOG_MAX_ARGS];
+    };
+
+    /**
+     * @brief Ring storage; slot sequence numbers are set before setup() runs
+     */
+    struct DlogRing {
+        DlogSlot slots[DLOG_QUEUE_LEN];
+        std::atomic<uint32_t> head{0};     ///< Next position to produce
+        std::atomic<uint32_t> tail{0};     ///< Next position to consume
+        std::atomic<uint32_t> dropped{0};
+
+        DlogRing() {
+            for (uint32_t i = 0; i < DLOG_QUEUE_LEN; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    };
+
+    DlogRing ring;
+
+    /**
+     * @brief Record copied out of the ring by the consumer
+     */
+    struct DlogRecord {
+        const char* fmt;
+        uint8_t level;
+        uint8_t count;
+        uint16_t types;
+        DlogValue args[DLOG_MAX_ARGS];
+    };
+
+    bool dlogPop(DlogRecord& out) {
+        uint32_t pos = ring.tail.load(std::memory_order_relaxed);
+        DlogSlot* slot;
+        for (;;) {
+            slot = &ring.slots[pos & (DLOG_QUEUE_LEN - 1)];
+            int32_t dif = (int32_t)(slot->seq.load(std::memory_order_acquire) - (pos + 1));
+            if (dif == 0) {
+                if (ring.tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;  // Empty (or the producer has not published yet)
+            } else {
+                pos = ring.tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        out.fmt = slot->fmt;
+        out.level = slot->level;
+        out.count = slot->count;
+        out.types = slot->types;
+        memcpy(out.args, slot->args, sizeof(out.args));
+        slot->seq.store(pos + DLOG_QUEUE_LEN, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Format one record with the argument types captured at the call site
+     * @details Each conversion spec is handed to snprintf on its own with
+     *          the stored value converted to what the spec expects;
+     *          length modifiers (l, h, z) are dropped since every stored
+     *          integer is 32 bits
+     */
+    size_t formatRecord(const DlogRecord& r, char* out, size_t size) {
+        size_t n = 0;
+        int arg = 0;
+        const char* p = r.fmt;
+
+        while (*p && n + 1 < size) {
+            if (*p != '%') {
+                out[n++] = *p++;
+                continue;
+            }
+            if (p[1] == '%') {
+                out[n++] = '%';
+                p += 2;
+                continue;
+            }
+
+            // Copy "%[flags][width][.prec]" and find the conversion
+            char spec[16];
+            size_t s = 0;
+            spec[s++] = *p++;
+            while (*p && strchr("-+ #0123456789.lhz", *p)) {
+                if (!strchr("lhz", *p) && s < sizeof(spec) - 2) spec[s++] = *p;
+                p++;
+            }
+            char conv = *p ? *p++ : 'd';
+            spec[s++] = conv;
+            spec[s] = '\0';
+
+            if (arg >= r.count) break;  // Malformed call: more specs than arguments
+            DlogArgType type = (DlogArgType)((r.types >> (2 * arg)) & 3);
+            const DlogValue& v = r.args[arg++];
+
+            int w;
+            if (strchr("fFeEgGaA", conv)) {
+                double d = type == DLOG_ARG_FLOAT ? v.f : type == DLOG_ARG_INT ? (double)v.i : (double)v.u;
+                w = snprintf(out + n, size - n, spec, d);
+            } else if (conv == 's') {
+                w = snprintf(out + n, size - n, spec, type == DLOG_ARG_STR && v.s ? v.s : "?");
+            } else if (conv == 'p') {
+                w = snprintf(out + n, size - n, spec, (void*)v.s);
+            } else {
+                int i = type == DLOG_ARG_FLOAT ? (int)v.f : v.i;
+                w = snprintf(out + n, size - n, spec, i);
+            }
+            if (w > 0) n += (size_t)w < size - n ? (size_t)w : size - n - 1;
+        }
+
+        out[n] = '\0';
+        return n;
+    }
+
+#if DLOG_BENCH
+    /**
+     * @brief Cost per log call: Serial.printf vs deferred record
+     * @details Runs before the drain loop starts. Deferred calls are timed
+     *          in batches of half the ring and discarded between batches,
+     *          so the figure is the producer cost only
+     */
+    void runLogBench() {
+        constexpr int kCalls = 256;
+        const char* fmt = "[BENCH] Temp band changed: %s (%.1f°C) run %u\n";
+        float t = 23.4f;
+
+        Serial.printf("\n[LOG] ===== Cost per log call (%d calls) =====\n", kCalls);
+        Serial.flush();
+
+        uint32_t c0 = ESP.getCycleCount();
+        for (int i = 0; i < kCalls; i++) Serial.printf(fmt, "NORMAL", t, (unsigned)i);
+        uint32_t syncCycles = ESP.getCycleCount() - c0;
+        Serial.flush();
+
+        uint32_t deferredCycles = 0;
+        DlogRecord discard;
+        for (int done = 0; done < kCalls; ) {
+            int batch = DLOG_QUEUE_LEN / 2;
+            c0 = ESP.getCycleCount();
+            for (int i = 0; i < batch; i++) dlogWrite(DLOG_LEVEL_INFO, fmt, "NORMAL", t, (unsigned)(done + i));
+            deferredCycles += ESP.getCycleCount() - c0;
+            while (dlogPop(discard)) {}
+            done += batch;
+        }
+
+        // Formatting cost moved to the LOG task
+        char line[DLOG_LINE_MAX];
+        dlogWrite(DLOG_LEVEL_INFO, fmt, "NORMAL", t, 0u);
+        dlogPop(discard);
+        c0 = ESP.getCycleCount();
+        for (int i = 0; i < kCalls; i++) formatRecord(discard, line, sizeof(line));
+        uint32_t formatCycles = ESP.getCycleCount() - c0;
+
+        uint32_t mhz = ESP.getCpuFreqMHz();
+        Serial.printf("[LOG] Serial.printf : %6u cycles/call (%.1f us)\n",
+                      (unsigned)(syncCycles / kCalls), (float)syncCycles / kCalls / mhz);
+        Serial.printf("[LOG] Deferred      : %6u cycles/call (%.1f us)\n",
+                      (unsigned)(deferredCycles / kCalls), (float)deferredCycles / kCalls / mhz);
+        Serial.printf("[LOG] LOG task fmt  : %6u cycles/record (%.1f us, off the hot path)\n",
+                      (unsigned)(formatCycles / kCalls), (float)formatCycles / kCalls / mhz);
+        Serial.printf("[LOG] Disabled site : 0 cycles (removed at compile time, DLOG_LEVEL=%d)\n", DLOG_LEVEL);
+    }
+#endif
+} // namespace
+
+/* ====== Public Functions ====== */
+
+bool dlogPush(uint8_t level, const char* fmt, const DlogArg* args, uint8_t count) {
+    uint32_t pos = ring.head.load(std::memory_order_relaxed);
+    DlogSlot* slot;
+    for (;;) {
+        slot = &ring.slots[pos & (DLOG_QUEUE_LEN - 1)];
+        int32_t dif = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+        if (dif == 0) {
+            if (ring.head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);  // Full
+            return false;
+        } else {
+            pos = ring.head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->fmt = fmt;
+    slot->level = level;
+    slot->count = count;
+    uint16_t types = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        types |= (uint16_t)args[i].type << (2 * i);
+        slot->args[i] = args[i].value;
+    }
+    slot->types = types;
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t dlogDropped() {
+    return ring.dropped.load(std::memory_order_relaxed);
+}
+
+void task_log(void* pv) {
+#if DLOG_BENCH
+    runLogBench();
+#endif
+
+    char line[DLOG_LINE_MAX];   // Formatting happens here, not in the producers
+    DlogRecord r;
+    uint32_t droppedReported = 0;
+
+    for (;;) {
+        while (dlogPop(r)) {
+            size_t n = formatRecord(r, line, sizeof(line));
+            Serial.write((const uint8_t*)line, n);
+        }
+
+        uint32_t dropped = dlogDropped();
+        if (dropped != droppedReported) {
+            Serial.printf("[LOG] ✗ %u records dropped (ring full)\n", (unsigned)(dropped - droppedReported));
+            droppedReported = dropped;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(DLOG_DRAIN_MS));
+    }
+}
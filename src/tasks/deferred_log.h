@@ -0,0 +1,137 @@
+/**
+ * @file deferred_log.h
+ * @brief Deferred Logger - Lock-free log records formatted by a low-priority task
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * A log call stores the format string pointer (the format ID: literals live
+ * in flash and never move) plus up to DLOG_MAX_ARGS typed 32-bit arguments
+ * in a lock-free multi-producer ring. The LOG task drains the ring every
+ * DLOG_DRAIN_MS, formats each record and writes it to Serial, so the
+ * calling task never formats floats on its stack or blocks on USB CDC.
+ *
+ * Usage (same format strings as Serial.printf):
+ *   DLOG_I("[TASK1] ✓ Temp band changed: %s (%.1f°C)\n", bandName(t), tC);
+ *
+ * Rules for arguments:
+ * - Integers up to 32 bits, float/double (stored as float), const char*
+ * - Strings are stored by pointer: only literals / static tables
+ *   (bandName(), humName()), never stack buffers or String::c_str()
+ *
+ * Levels: sites above DLOG_LEVEL expand to nothing (format string and
+ * argument evaluation are removed at compile time). With
+ * DEFERRED_LOG_ENABLED=0 the macros call Serial.printf directly.
+ *
+ * A full ring drops the record and counts it; producers never wait.
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "../config/config.h"
+
+/* ====== Record Arguments ====== */
+
+enum DlogArgType : uint8_t {
+    DLOG_ARG_INT = 0,
+    DLOG_ARG_UINT,
+    DLOG_ARG_FLOAT,
+    DLOG_ARG_STR
+};
+
+/**
+ * @brief One argument value (4 bytes on the ESP32)
+ */
+union DlogValue {
+    int32_t i;
+    uint32_t u;
+    float f;
+    const char* s;
+};
+
+/**
+ * @brief Argument captured at the call site with its type
+ */
+struct DlogArg {
+    DlogArgType type;
+    DlogValue value;
+
+    DlogArg() : type(DLOG_ARG_INT) { value.u = 0; }
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    DlogArg(T v) : type(std::is_signed<T>::value ? DLOG_ARG_INT : DLOG_ARG_UINT) {
+        static_assert(sizeof(T) <= 4, "64-bit log arguments are not supported");
+        value.u = (uint32_t)v;
+    }
+
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    DlogArg(T v) : type(DLOG_ARG_FLOAT) { value.f = (float)v; }
+
+    DlogArg(const char* s) : type(DLOG_ARG_STR) { value.s = s; }
+};
+
+/* ====== Producer API ====== */
+
+/**
+ * @brief Append one record to the ring (lock-free, never blocks)
+ * @return false when the ring was full and the record was dropped
+ */
+bool dlogPush(uint8_t level, const char* fmt, const DlogArg* args, uint8_t count);
+
+/**
+ * @brief Typed front end used by the DLOG_* macros
+ */
+template <typename... Args>
+inline void dlogWrite(uint8_t level, const char* fmt, Args... args) {
+    static_assert(sizeof...(Args) <= DLOG_MAX_ARGS, "too many log arguments");
+    const DlogArg in[] = { DlogArg(args)..., DlogArg() };  // Trailing element allows zero args
+    dlogPush(level, fmt, in, sizeof...(Args));
+}
+
+#if DEFERRED_LOG_ENABLED
+  #define DLOG_EMIT(level, ...) dlogWrite(level, __VA_ARGS__)
+#else
+  #define DLOG_EMIT(level, ...) Serial.printf(__VA_ARGS__)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_ERROR
+  #define DLOG_E(...) DLOG_EMIT(DLOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+  #define DLOG_E(...) do {} while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_WARN
+  #define DLOG_W(...) DLOG_EMIT(DLOG_LEVEL_WARN, __VA_ARGS__)
+#else
+  #define DLOG_W(...) do {} while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_INFO
+  #define DLOG_I(...) DLOG_EMIT(DLOG_LEVEL_INFO, __VA_ARGS__)
+#else
+  #define DLOG_I(...) do {} while (0)
+#endif
+
+#if DLOG_LEVEL >= DLOG_LEVEL_DEBUG
+  #define DLOG_D(...) DLOG_EMIT(DLOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+  #define DLOG_D(...) do {} while (0)
+#endif
+
+/* ====== Consumer ====== */
+
+/**
+ * @brief Records dropped because the ring was full
+ */
+uint32_t dlogDropped();
+
+/**
+ * @brief FreeRTOS task that formats and prints queued records
+ *        (created from the task table when DEFERRED_LOG_ENABLED)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_log(void* pv);
+
+#endif // DEFERRED_LOG_H
@@ -0,0 +1,294 @@
+/**
+ * @file executor.cpp
+ * @brief Cooperative Executor - Single-task run-to-completion scheduler
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Executor loop (EXECUTOR_MODE=1):
+ *   1. Run every job whose deadline has passed (step(false))
+ *   2. Sleep on the event queue until the earliest remaining deadline
+ *   3. Run the consumer of each received event (step(true))
+ *
+ * With five jobs a linear deadline scan is cheaper than maintaining a
+ * timer wheel, and it keeps the loop free of dynamic allocation.
+ */
+
+#include "executor.h"
+#include "tasks.h"
+#include "latency_bench.h"
+#include "led_service.h"
+#include "task_monitor.h"
+#include "trace_recorder.h"
+#include "../config/config.h"
+#include "../hardware/hardware_manager.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+EventLatency gEventLatency[EV_COUNT];
+
+/* ====== Local State ====== */
+
+namespace {
+    volatile int64_t eventPostUs[EV_COUNT];   ///< Time of the last signalEvent() per event
+
+    /**
+     * @brief Binary semaphore carrying an event in multi-task mode
+     * @note In IRAM: also called from signalEventFromISR()
+     */
+    SemaphoreHandle_t IRAM_ATTR eventSemaphore(ExecEvent ev) {
+        switch (ev) {
+            case EV_BAND_CHANGED: return semBandChanged;
+            case EV_HUM_CHANGED:  return semHumChanged;
+            case EV_UI_MODE:      return semUiMode;
+            default:              return semLcdUpdate;
+        }
+    }
+
+    /**
+     * @brief Event the consuming job waits on
+     * @details The LED service consumes both LED layer requests, so the UI
+     *          mode event is delivered through the humidity event's
+     *          semaphore / job
+     * @note In IRAM: also called from signalEventFromISR()
+     */
+    ExecEvent IRAM_ATTR consumerEvent(ExecEvent ev) {
+        if (LED_SERVICE && ev == EV_UI_MODE) return EV_HUM_CHANGED;
+        return ev;
+    }
+
+    /**
+     * @brief Trace label of an event (semaphore name)
+     */
+    uint8_t eventLabel(ExecEvent ev) {
+        static const uint8_t labels[EV_COUNT] = {
+            traceLabel("semBandChanged"), traceLabel("semHumChanged"), traceLabel("semLcdUpdate"),
+            traceLabel("semUiMode")
+        };
+        return labels[ev];
+    }
+
+    /**
+     * @brief Record producer → consumer latency for a delivered event
+     * @details Each post is measured once: a wake-up through a shared
+     *          semaphore (LED service) finds no stamp for the other event
+     */
+    void recordLatency(ExecEvent ev) {
+        traceRecord(TRACE_TAKE, eventLabel(ev));
+        int64_t posted = eventPostUs[ev];
+        if (posted == 0) return;
+        eventPostUs[ev] = 0;
+        int64_t dt = esp_timer_get_time() - posted;
+        if (dt < 0) return;
+        EventLatency& l = gEventLatency[ev];
+        l.count++;
+        l.sumUs += (uint64_t)dt;
+        if ((uint32_t)dt > l.maxUs) l.maxUs = (uint32_t)dt;
+    }
+
+#if EXECUTOR_MODE
+    /**
+     * @brief One job hosted by the executor
+     */
+    struct ExecJob {
+        const char* name;
+        void (*init)();
+        uint32_t (*step)(bool signaled);
+        ExecEvent event;          ///< Event that wakes the job (EV_NONE = periodic)
+        uint32_t deadline;        ///< millis() of the next timeout
+        bool timed;               ///< false = waiting for the event only
+        uint32_t steps;           ///< Step count
+        uint8_t label;            ///< Trace label (job name)
+        uint32_t maxStepUs;       ///< Longest step (run-to-completion budget)
+    };
+
+    ExecJob jobs[] = {
+        { "DHT20",  sensorInit, sensorStep, EV_NONE },
+        { "LED",    ledInit,    ledStep,    EV_BAND_CHANGED },
+#if LED_SERVICE
+        { "LEDS",   ledServiceInit, ledServiceStep, EV_HUM_CHANGED },
+#else
+        { "NEO_H",  neoHumInit, neoHumStep, EV_HUM_CHANGED },
+        { "NEO_UI", neoUiInit,  neoUiStep,  EV_UI_MODE },
+#endif
+        { "LCD",    lcdInit,    lcdStep,    EV_LCD_UPDATE },
+    };
+    constexpr int kJobCount = sizeof(jobs) / sizeof(jobs[0]);
+
+    QueueHandle_t eventQueue = nullptr;
+
+    /**
+     * @brief Run one step and schedule the job's next timeout
+     */
+    void runJob(ExecJob& j, bool signaled) {
+        traceRecord(TRACE_RUN_BEGIN, j.label);
+        int64_t t0 = esp_timer_get_time();
+        uint32_t next = j.step(signaled);
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        traceRecord(TRACE_RUN_END, j.label);
+
+        j.steps++;
+        if (us > j.maxStepUs) j.maxStepUs = us;
+        j.timed = next != kWaitForever;
+        if (j.timed) j.deadline = millis() + next;
+    }
+#endif
+} // namespace
+
+/* ====== Event Delivery ====== */
+
+void signalEvent(ExecEvent ev) {
+    traceRecord(TRACE_GIVE, eventLabel(ev));
+    eventPostUs[ev] = esp_timer_get_time();
+    latencyPost(ev);
+    ledServicePost(ev);
+    wakeEvent(ev);
+}
+
+void wakeEvent(ExecEvent ev) {
+#if EXECUTOR_MODE
+    if (eventQueue != nullptr) {
+        uint8_t item = ev;
+        xQueueSend(eventQueue, &item, 0);  // Full queue = event already pending
+    }
+#else
+    xSemaphoreGive(eventSemaphore(consumerEvent(ev)));
+#endif
+}
+
+void IRAM_ATTR signalEventFromISR(ExecEvent ev) {
+    BaseType_t woken = pdFALSE;
+#if EXECUTOR_MODE
+    if (eventQueue != nullptr) {
+        uint8_t item = ev;
+        xQueueSendFromISR(eventQueue, &item, &woken);
+    }
+#else
+    xSemaphoreGiveFromISR(eventSemaphore(consumerEvent(ev)), &woken);
+#endif
+    if (woken) portYIELD_FROM_ISR();
+}
+
+/* ====== Dedicated Task Mode ====== */
+
+void runAsTask(uint32_t (*step)(bool), ExecEvent ev) {
+    bool signaled = false;
+    uint8_t label = traceLabel(pcTaskGetName(nullptr));
+
+    for (;;) {
+        traceRecord(TRACE_RUN_BEGIN, label);
+        uint32_t wait = step(signaled);
+        traceRecord(TRACE_RUN_END, label);
+        TickType_t ticks = wait == kWaitForever ? portMAX_DELAY : pdMS_TO_TICKS(wait);
+
+        if (ev == EV_NONE) {
+            vTaskDelay(ticks);
+            signaled = false;
+        } else {
+            // SEMAPHORE WAIT: timeout or event, whichever comes first
+            signaled = xSemaphoreTake(eventSemaphore(ev), ticks) == pdTRUE;
+            if (signaled) recordLatency(ev);
+        }
+    }
+}
+
+/* ====== Cooperative Executor ====== */
+
+void task_executor(void* pv) {
+#if EXECUTOR_MODE
+#if STATIC_ALLOCATION
+    static StaticQueue_t queueBuffer;
+    static uint8_t queueStorage[EXEC_QUEUE_LEN];
+    eventQueue = xQueueCreateStatic(EXEC_QUEUE_LEN, sizeof(uint8_t), queueStorage, &queueBuffer);
+#else
+    eventQueue = xQueueCreate(EXEC_QUEUE_LEN, sizeof(uint8_t));
+#endif
+
+    Serial.printf("[EXEC] Cooperative executor started (%d jobs, one task)\n", kJobCount);
+
+    for (ExecJob& j : jobs) {
+        j.label = traceLabel(j.name);
+        j.init();
+    }
+    for (ExecJob& j : jobs) runJob(j, false);  // First pass sets each job's deadline
+
+    for (;;) {
+        // 1. Timeouts
+        uint32_t now = millis();
+        for (ExecJob& j : jobs) {
+            if (j.timed && (int32_t)(now - j.deadline) >= 0) runJob(j, false);
+        }
+
+        // 2. Sleep until the earliest deadline or the next event
+        now = millis();
+        uint32_t wait = kWaitForever;
+        for (const ExecJob& j : jobs) {
+            if (!j.timed) continue;
+            int32_t left = (int32_t)(j.deadline - now);
+            uint32_t ms = left > 0 ? (uint32_t)left : 0;
+            if (ms < wait) wait = ms;
+        }
+        TickType_t ticks = wait == kWaitForever ? portMAX_DELAY : pdMS_TO_TICKS(wait);
+
+        // 3. Events (drain everything that arrived while running)
+        uint8_t ev;
+        if (xQueueReceive(eventQueue, &ev, ticks) != pdTRUE) continue;
+        do {
+            if (ev >= EV_COUNT) continue;
+            recordLatency((ExecEvent)ev);
+            for (ExecJob& j : jobs) {
+                if (j.event == consumerEvent((ExecEvent)ev)) runJob(j, true);
+            }
+        } while (xQueueReceive(eventQueue, &ev, 0) == pdTRUE);
+    }
+#else
+    vTaskDelete(nullptr);
+#endif
+}
+
+/* ====== Benchmark ====== */
+
+void task_exec_bench(void* pv) {
+#if EXECUTOR_BENCH
+    vTaskDelay(pdMS_TO_TICKS(EXEC_BENCH_DURATION_MS));
+
+    Serial.printf("\n[EXEC] ===== %s design, %d s =====\n",
+                  EXECUTOR_MODE ? "Cooperative executor" : "Multi-task", EXEC_BENCH_DURATION_MS / 1000);
+
+    // RAM: stacks reserved by our tasks + heap
+    TaskHandle_t handles[16];
+    int n = taskTableHandles(handles, 16);
+    uint32_t stackBytes = 0, stackUsed = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t size = taskStackSize(handles[i]);
+        stackBytes += size;
+        stackUsed += size - uxTaskGetStackHighWaterMark(handles[i]);
+    }
+    Serial.printf("[EXEC] Tasks: %d from table, %u total | Stacks: %u bytes reserved, %u used\n",
+                  n, (unsigned)uxTaskGetNumberOfTasks(), (unsigned)stackBytes, (unsigned)stackUsed);
+    Serial.printf("[EXEC] Heap: %u free, %u minimum free\n",
+                  (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap());
+
+    // Context switches (tick-hook count from the task monitor)
+    static TaskStat snap[TASK_MON_MAX_TASKS];
+    int m = taskMonitorSnapshot(snap, TASK_MON_MAX_TASKS);
+    float switches = 0.0f;
+    for (int i = 0; i < m; i++) switches += snap[i].switchesPerSec;
+    if (m > 0) Serial.printf("[EXEC] Context switches: %.0f /s (all tasks, tick resolution)\n", switches);
+    else       Serial.println("[EXEC] Context switches: n/a (TASK_MONITOR_ENABLED=0)");
+
+    // Event latency
+    static const char* const names[EV_COUNT] = { "BandChanged", "HumChanged", "LcdUpdate", "UiMode" };
+    for (int e = 0; e < EV_COUNT; e++) {
+        const EventLatency& l = gEventLatency[e];
+        Serial.printf("[EXEC] Latency %-11s: %u events, mean %u us, max %u us\n", names[e], (unsigned)l.count,
+                      l.count ? (unsigned)(l.sumUs / l.count) : 0u, (unsigned)l.maxUs);
+    }
+
+#if EXECUTOR_MODE
+    for (const ExecJob& j : jobs) {
+        Serial.printf("[EXEC] Job %-6s: %u steps, longest %u us\n", j.name, (unsigned)j.steps, (unsigned)j.maxStepUs);
+    }
+#endif
+#endif
+    vTaskDelete(nullptr);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file executor.h
+ * @brief Job Interface - Task bodies as non-blocking step functions
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Every periodic/event-driven task body is split into:
+ *   - init():          one-time setup (pins, strips, LCD splash)
+ *   - step(signaled):  one run-to-completion pass; `signaled` is true when
+ *                      the job's event arrived, false on timeout. Returns
+ *                      the delay (ms) until the next timeout, or
+ *                      kWaitForever to wait for the event only.
+ *
+ * The same step functions run in two build modes:
+ *
+ *   EXECUTOR_MODE=0 (default)   one FreeRTOS task per job; runAsTask()
+ *                               blocks on the job's semaphore with the
+ *                               returned timeout (original behavior)
+ *   EXECUTOR_MODE=1             a single EXEC task runs every job from an
+ *                               event queue plus a deadline scan
+ *
+ * Producers call signalEvent(), which gives the semaphore or posts to
+ * the executor queue depending on the mode.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Step return value: no timeout, wait for the event only
+ */
+constexpr uint32_t kWaitForever = UINT32_MAX;
+
+/**
+ * @brief Events exchanged between jobs (one per former binary semaphore)
+ */
+enum ExecEvent : uint8_t {
+    EV_BAND_CHANGED = 0,   ///< semBandChanged: Task 1 → LED
+    EV_HUM_CHANGED,        ///< semHumChanged:  Task 1 → NeoPixel humidity
+    EV_LCD_UPDATE,         ///< semLcdUpdate:   Task 1 → LCD
+    EV_UI_MODE,            ///< semUiMode:      Web → NeoPixel UI
+    EV_COUNT,
+    EV_NONE = 0xFF         ///< Job is purely periodic
+};
+
+/**
+ * @brief Producer → consumer latency per event (give/post → step start)
+ */
+struct EventLatency {
+    uint32_t count;        ///< Deliveries measured
+    uint32_t maxUs;        ///< Worst latency
+    uint64_t sumUs;        ///< For the mean
+};
+
+extern EventLatency gEventLatency[EV_COUNT];
+
+/* ====== Job Step Functions ====== */
+
+void sensorInit();                  ///< task1_sensor.cpp
+uint32_t sensorStep(bool signaled);
+void ledInit();                     ///< task2_led_neopixel.cpp
+uint32_t ledStep(bool signaled);
+void neoHumInit();
+uint32_t neoHumStep(bool signaled);
+void neoUiInit();
+uint32_t neoUiStep(bool signaled);
+void lcdInit();                     ///< task3_lcd.cpp
+uint32_t lcdStep(bool signaled);
+void ledServiceInit();              ///< led_service.cpp (LED_SERVICE=1)
+uint32_t ledServiceStep(bool signaled);
+
+/* ====== Runtime ====== */
+
+/**
+ * @brief Deliver an event to its consumer job
+ * @note Safe to call from any task (not from ISRs)
+ */
+void signalEvent(ExecEvent ev);
+
+/**
+ * @brief Wake the consumer of an event without posting it
+ * @note No trace record, no latency stamp, no LED service request: for
+ *       re-running a job whose state changed outside its event
+ */
+void wakeEvent(ExecEvent ev);
+
+/**
+ * @brief signalEvent() for interrupt handlers (button inputs)
+ * @note Wakes the consumer only: no trace record, no latency stamp
+ */
+void signalEventFromISR(ExecEvent ev);
+
+/**
+ * @brief Run a job as a dedicated FreeRTOS task (never returns)
+ * @param step Job step function
+ * @param ev Event the job waits on, EV_NONE for a periodic job
+ */
+[[noreturn]] void runAsTask(uint32_t (*step)(bool), ExecEvent ev);
+
+/**
+ * @brief Cooperative executor task running every job (EXECUTOR_MODE=1)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_executor(void* pv);
+
+/**
+ * @brief Prints the RAM / context switch / latency comparison (EXECUTOR_BENCH=1)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_exec_bench(void* pv);
+
+#endif // EXECUTOR_H
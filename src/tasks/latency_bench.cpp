@@ -0,0 +1,192 @@
+/**
+ * @file latency_bench.cpp
+ * @brief Latency Benchmark - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Each edge has one pending start stamp (low 32 bits of esp_timer µs,
+ * 0 = none). Producers overwrite it, so a stamp the consumer has not acted
+ * on yet is replaced by the newer one, matching the binary semaphore the
+ * consumer waits on. The consumer exchanges it with 0 and adds the
+ * difference to the edge statistics, which only that consumer writes.
+ */
+
+#include "latency_bench.h"
+
+#if LATENCY_BENCH
+
+#include <WiFi.h>
+#include <atomic>
+#include "esp_random.h"
+#include "esp_timer.h"
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr int kBuckets = 16;            ///< log2 µs: <16, <32, ... <256k, >=256k
+    constexpr uint32_t kWarmupMs = 3000;    ///< Skip the LCD splash and first readings
+
+    /**
+     * @brief Statistics of one edge (single writer: the consumer)
+     */
+    struct EdgeStat {
+        const char* name;
+        uint32_t count;
+        uint64_t sumUs;
+        uint32_t maxUs;
+        uint32_t hist[kBuckets];
+    };
+
+    EdgeStat stats[LAT_EDGE_COUNT] = {
+        { "BAND->LED" },
+        { "HUM->NEO" },
+        { "LCD->REPAINT" },
+        { "SAMPLE->LCD" },
+    };
+
+    std::atomic<uint32_t> pending[LAT_EDGE_COUNT];
+    volatile bool measuring = false;        ///< Inside the measurement window
+
+    uint32_t httpOk = 0;
+    uint32_t httpFailed = 0;
+    uint32_t stimuli = 0;
+
+    inline uint32_t nowUs() {
+        uint32_t t = (uint32_t)esp_timer_get_time();
+        return t == 0 ? 1 : t;  // 0 means "no stamp"
+    }
+
+    /**
+     * @brief Our own address: the station IP once joined, else the AP IP
+     */
+    IPAddress selfIP() {
+        return (WiFi.getMode() & WIFI_MODE_STA) ? WiFi.localIP() : WiFi.softAPIP();
+    }
+
+    int bucketOf(uint32_t us) {
+        int b = 32 - __builtin_clz(us | 1) - 4;   // Bit length - 4
+        if (b < 0) return 0;
+        return b < kBuckets - 1 ? b : kBuckets - 1;
+    }
+
+    /**
+     * @brief Upper bound (µs) of the bucket holding the q-th percentile
+     */
+    uint32_t percentileBound(const EdgeStat& s, uint32_t q) {
+        uint32_t target = (s.count * q + 99) / 100;
+        uint32_t seen = 0;
+        for (int b = 0; b < kBuckets - 1; b++) {
+            seen += s.hist[b];
+            if (seen >= target) return 16u << b;
+        }
+        return s.maxUs;
+    }
+
+    void printReport() {
+        Serial.printf("\n[LAT] ===== Inter-task latency, %d s, EXECUTOR_MODE=%d =====\n",
+                      LAT_BENCH_DURATION_MS / 1000, EXECUTOR_MODE);
+        Serial.printf("[LAT] Load: http=%s cpu=%s tinyml every %d ms, %u stimuli\n",
+                      (LATENCY_BENCH_LOAD & LAT_LOAD_HTTP) ? "on" : "off",
+                      (LATENCY_BENCH_LOAD & LAT_LOAD_CPU) ? "on" : "off",
+                      TINYML_INFERENCE_MS, (unsigned)stimuli);
+        if (LATENCY_BENCH_LOAD & LAT_LOAD_HTTP) {
+            Serial.printf("[LAT] HTTP flood: %u ok, %u failed\n", (unsigned)httpOk, (unsigned)httpFailed);
+        }
+
+        Serial.println("[LAT] Edge            count   mean    p50<=   p90<=   p99<=   max (us)");
+        for (const EdgeStat& s : stats) {
+            if (s.count == 0) {
+                Serial.printf("[LAT] %-14s %6u   no samples\n", s.name, 0u);
+                continue;
+            }
+            Serial.printf("[LAT] %-14s %6u %6u %7u %7u %7u %7u\n", s.name, (unsigned)s.count,
+                          (unsigned)(s.sumUs / s.count), (unsigned)percentileBound(s, 50),
+                          (unsigned)percentileBound(s, 90), (unsigned)percentileBound(s, 99),
+                          (unsigned)s.maxUs);
+        }
+
+        // Histograms: bucket b holds [16 << (b-1), 16 << b) µs, the last one everything above
+        Serial.print("[LAT] Histogram <us:");
+        for (int b = 0; b < kBuckets - 1; b++) Serial.printf(" %u", 16u << b);
+        Serial.println(" more");
+        for (const EdgeStat& s : stats) {
+            Serial.printf("[LAT] %-14s", s.name);
+            for (int b = 0; b < kBuckets; b++) Serial.printf(" %u", (unsigned)s.hist[b]);
+            Serial.println();
+        }
+    }
+} // namespace
+
+/* ====== Hooks ====== */
+
+void latencyPost(ExecEvent ev) {
+    switch (ev) {
+        case EV_BAND_CHANGED: pending[LAT_BAND_LED].store(nowUs(), std::memory_order_relaxed); break;
+        case EV_HUM_CHANGED:  pending[LAT_HUM_NEO].store(nowUs(), std::memory_order_relaxed); break;
+        case EV_LCD_UPDATE:   pending[LAT_LCD_REPAINT].store(nowUs(), std::memory_order_relaxed); break;
+        default: break;
+    }
+}
+
+void latencySample() {
+    pending[LAT_SAMPLE_LCD].store(nowUs(), std::memory_order_relaxed);
+}
+
+void latencyMark(LatencyEdge edge) {
+    uint32_t t0 = pending[edge].exchange(0, std::memory_order_relaxed);
+    if (t0 == 0 || !measuring) return;
+
+    uint32_t us = nowUs() - t0;
+    EdgeStat& s = stats[edge];
+    s.count++;
+    s.sumUs += us;
+    if (us > s.maxUs) s.maxUs = us;
+    s.hist[bucketOf(us)]++;
+}
+
+/* ====== Tasks ====== */
+
+void task_lat_stimulus(void* pv) {
+    vTaskDelay(pdMS_TO_TICKS(kWarmupMs));
+    for (;;) {
+        // Random phase so the stimulus does not lock onto the consumers' periods
+        vTaskDelay(pdMS_TO_TICKS(LAT_BENCH_STIMULUS_MS + esp_random() % 8));
+        signalEvent(EV_BAND_CHANGED);
+        signalEvent(EV_HUM_CHANGED);
+        stimuli++;
+    }
+}
+
+void task_lat_http(void* pv) {
+    vTaskDelay(pdMS_TO_TICKS(kWarmupMs));
+    for (;;) {
+        WiFiClient client;
+        IPAddress ip = selfIP();
+        if (client.connect(ip, 80)) {
+            client.print("GET /state HTTP/1.1\r\nHost: " + ip.toString() + "\r\nConnection: close\r\n\r\n");
+            uint32_t deadline = millis() + 2000;
+            while (client.connected() && (int32_t)(deadline - millis()) > 0) {
+                while (client.available()) client.read();
+                vTaskDelay(1);
+            }
+            client.stop();
+            httpOk++;
+        } else {
+            httpFailed++;
+        }
+        vTaskDelay(pdMS_TO_TICKS(LAT_BENCH_HTTP_PERIOD_MS));
+    }
+}
+
+void task_lat_report(void* pv) {
+    vTaskDelay(pdMS_TO_TICKS(kWarmupMs));
+    Serial.printf("[LAT] Measuring for %d s\n", LAT_BENCH_DURATION_MS / 1000);
+    measuring = true;
+    vTaskDelay(pdMS_TO_TICKS(LAT_BENCH_DURATION_MS));
+    measuring = false;
+
+    printReport();
+    vTaskDelete(nullptr);
+}
+
+#endif // LATENCY_BENCH
@@ -0,0 +1,83 @@
+/**
+ * @file latency_bench.h
+ * @brief Latency Benchmark - Producer → consumer latency per synchronization edge
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Edges (start stamp → consumer has acted):
+ *   BAND→LED     signalEvent(EV_BAND_CHANGED) → LED pin written
+ *   HUM→NEO      signalEvent(EV_HUM_CHANGED)  → humidity pixel shown
+ *   LCD→REPAINT  signalEvent(EV_LCD_UPDATE)   → LCD repaint finished
+ *   SAMPLE→LCD   DHT20 read finished          → LCD repaint finished
+ *
+ * Band and humidity changes are rare, so a stimulus task signals both
+ * every LAT_BENCH_STIMULUS_MS (with a few ms of phase jitter). Optional
+ * synthetic load (LATENCY_BENCH_LOAD bits): loopback HTTP flood,
+ * back-to-back TinyML inference, ~80% CPU burner on each core.
+ *
+ * Timestamps come from esp_timer (µs, shared by both cores); the per-core
+ * cycle counters are not synchronized, so they cannot time cross-core
+ * edges. Each edge keeps count / mean / max and a log2 histogram, and the
+ * report prints p50 / p90 / p99 as histogram bucket bounds.
+ *
+ * @note Built by the [env:bench_latency*] PlatformIO environments
+ */
+
+#ifndef LATENCY_BENCH_H
+#define LATENCY_BENCH_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+#include "executor.h"
+
+/**
+ * @brief Measured producer → consumer edges
+ */
+enum LatencyEdge : uint8_t {
+    LAT_BAND_LED = 0,
+    LAT_HUM_NEO,
+    LAT_LCD_REPAINT,
+    LAT_SAMPLE_LCD,
+    LAT_EDGE_COUNT
+};
+
+#if LATENCY_BENCH
+/**
+ * @brief Start stamp for the edges fed by an event (called by signalEvent)
+ */
+void latencyPost(ExecEvent ev);
+
+/**
+ * @brief Start stamp for SAMPLE→LCD (called after the DHT20 read)
+ */
+void latencySample();
+
+/**
+ * @brief Consumer has acted: close the pending sample of an edge
+ */
+void latencyMark(LatencyEdge edge);
+#else
+inline void latencyPost(ExecEvent) {}
+inline void latencySample() {}
+inline void latencyMark(LatencyEdge) {}
+#endif
+
+/**
+ * @brief Signals EV_BAND_CHANGED / EV_HUM_CHANGED every LAT_BENCH_STIMULUS_MS
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_lat_stimulus(void* pv);
+
+/**
+ * @brief Loopback HTTP flood (LAT_LOAD_HTTP)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_lat_http(void* pv);
+
+/**
+ * @brief Prints the per-edge report after LAT_BENCH_DURATION_MS
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_lat_report(void* pv);
+
+#endif // LATENCY_BENCH_H
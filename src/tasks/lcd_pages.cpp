@@ -0,0 +1,253 @@
+/**
+ * @file lcd_pages.cpp
+ * @brief LCD Pages - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "lcd_pages.h"
+#include "executor.h"
+#include "../config/system_types.h"
+#include "../hardware/lcd_shadow.h"
+#include "esp_timer.h"
+#include <WiFi.h>
+#include <atomic>
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint8_t kSparkBlocks = 4;          ///< Glyphs per sparkline
+    constexpr uint8_t kBlockCols = 5;            ///< Pixel columns per glyph
+    constexpr uint8_t kGlyphRows = 8;
+    constexpr int8_t kNoRequest = -2;
+
+    /**
+     * @brief One sparkline: a ring of glyph blocks
+     */
+    struct Spark {
+        uint8_t slot0;                           ///< First of its kSparkBlocks CGRAM slots
+        float step;                              ///< Scale grid
+        float minSpan;                           ///< Smallest scale range
+        float col[kSparkBlocks][kBlockCols];     ///< Column means, NAN = empty
+        uint8_t newest;                          ///< Block being filled (rightmost cell)
+        uint8_t fill;                            ///< Committed columns in the newest block
+        float sum;                               ///< Readings of the column in progress
+        uint16_t n;
+    };
+
+    Spark sparks[2] = {
+        { 0,            0.5f, 2.0f },           // Temperature, °C
+        { kSparkBlocks, 2.0f, 8.0f },           // Humidity, %
+    };
+    uint32_t columnStartMs = 0;
+
+    uint8_t page = LCD_PAGE_SENSOR;
+    uint32_t pageShownMs = 0;
+    std::atomic<int8_t> request{kNoRequest};     ///< Set by the web and the button ISR
+    volatile int64_t lastPressUs = 0;
+
+    const char* const kPageNames[LCD_PAGE_COUNT] = { "sensor", "trend", "ml", "net" };
+
+    void sparkReset(Spark& s) {
+        for (auto& block : s.col) {
+            for (float& v : block) v = NAN;
+        }
+        s.newest = kSparkBlocks - 1;
+        s.fill = 0;
+        s.sum = 0;
+        s.n = 0;
+    }
+
+    /**
+     * @brief Close the column in progress
+     */
+    void sparkCommit(Spark& s) {
+        if (s.n == 0) return;
+        s.col[s.newest][s.fill++] = s.sum / s.n;
+        s.sum = 0;
+        s.n = 0;
+        if (s.fill == kBlockCols) {
+            // Oldest block (and its CGRAM slot) becomes the newest
+            s.newest = (s.newest + 1) % kSparkBlocks;
+            s.fill = 0;
+            for (float& v : s.col[s.newest]) v = NAN;
+        }
+    }
+
+    /**
+     * @brief Column value, including the mean of the column in progress
+     */
+    float sparkAt(const Spark& s, uint8_t block, uint8_t c) {
+        if (block == s.newest && c == s.fill) return s.n ? s.sum / s.n : NAN;
+        return s.col[block][c];
+    }
+
+    /**
+     * @brief Upload glyphs for every block and return the cell characters
+     */
+    void sparkRender(const Spark& s, char* cells) {
+        float lo = INFINITY, hi = -INFINITY;
+        for (uint8_t b = 0; b < kSparkBlocks; b++) {
+            for (uint8_t c = 0; c < kBlockCols; c++) {
+                float v = sparkAt(s, b, c);
+                if (isnan(v)) continue;
+                lo = min(lo, v);
+                hi = max(hi, v);
+            }
+        }
+        if (lo <= hi) {
+            lo = floorf(lo / s.step) * s.step;
+            hi = ceilf(hi / s.step) * s.step;
+            if (hi - lo < s.minSpan) {
+                lo = floorf(((lo + hi - s.minSpan) / 2) / s.step) * s.step;
+                hi = lo + s.minSpan;
+            }
+        }
+
+        for (uint8_t b = 0; b < kSparkBlocks; b++) {
+            uint8_t rows[kGlyphRows] = {};
+            for (uint8_t c = 0; c < kBlockCols; c++) {
+                float v = sparkAt(s, b, c);
+                if (isnan(v)) continue;
+                int h = 1 + (int)lroundf((v - lo) / (hi - lo) * (kGlyphRows - 1));
+                h = h < 1 ? 1 : (h > kGlyphRows ? kGlyphRows : h);
+                for (int r = kGlyphRows - h; r < kGlyphRows; r++) rows[r] |= 0x10 >> c;
+            }
+            lcdShadowGlyph(s.slot0 + b, rows);
+        }
+        // Oldest block leftmost, newest rightmost
+        for (uint8_t k = 0; k < kSparkBlocks; k++) {
+            cells[k] = LCD_GLYPH_CHAR(s.slot0 + (s.newest + 1 + k) % kSparkBlocks);
+        }
+        cells[kSparkBlocks] = '\0';
+    }
+
+    /* ---- Pages ---- */
+
+    void renderSensor() {
+        // Line 1: Task 1 - Actual Temperature and Humidity values
+        lcdShadowPrintf(0, "T:%.1fC H:%.0f%%", gLive.tC, gLive.rh);
+
+        // Line 2: Task 2 - Status/Condition of both Temperature and Humidity (abbreviated)
+        const char* tStatus = "";
+        switch (gLive.tBand) {
+            case TempBand::COLD:     tStatus = "COLD"; break;
+            case TempBand::NORMAL:   tStatus = "NORM"; break;
+            case TempBand::HOT:      tStatus = "HOT";  break;
+            case TempBand::CRITICAL: tStatus = "CRIT"; break;
+        }
+        const char* hStatus = "";
+        switch (gLive.hBand) {
+            case HumBand::DRY:     hStatus = "DRY"; break;
+            case HumBand::COMFORT: hStatus = "OK";  break;
+            case HumBand::HUMID:   hStatus = "HUM"; break;
+            case HumBand::WET:     hStatus = "WET"; break;
+        }
+        lcdShadowPrintf(1, "T:%s H:%s", tStatus, hStatus);
+    }
+
+    void renderTrend() {
+        char cells[2][kSparkBlocks + 1];
+        sparkRender(sparks[0], cells[0]);
+        sparkRender(sparks[1], cells[1]);
+        lcdShadowPrintf(0, "T%s %.1fC", cells[0], gLive.tC);
+        lcdShadowPrintf(1, "H%s %.0f%%", cells[1], gLive.rh);
+    }
+
+    void renderMl() {
+        float tiny = gLive.tinyml_score;
+        float stat = gLive.stat_score;
+        if (gLive.tinyml_ready && !isnan(tiny)) lcdShadowPrintf(0, "TinyML: %.3f", tiny);
+        else lcdShadowPrintf(0, "TinyML: --");
+        if (!isnan(stat)) lcdShadowPrintf(1, "Stat:   %.3f", stat);
+        else lcdShadowPrintf(1, "Stat:   --");
+    }
+
+    void renderNet() {
+        bool sta = (WiFi.getMode() & WIFI_MODE_STA) && WiFi.status() == WL_CONNECTED;
+        IPAddress ip = sta ? WiFi.localIP() : WiFi.softAPIP();
+        String ssid = sta ? WiFi.SSID() : WiFi.softAPSSID();
+        lcdShadowPrintf(0, "%s %u.%u.%u.%u", sta ? "STA" : "AP", ip[0], ip[1], ip[2], ip[3]);
+        lcdShadowPrintf(1, "%s", ssid.c_str());
+    }
+
+    /**
+     * @brief Page table (indexed by LcdPage)
+     */
+    void (* const kPageRender[LCD_PAGE_COUNT])() = { renderSensor, renderTrend, renderMl, renderNet };
+
+#if LCD_PAGE_BUTTON_PIN >= 0
+    void IRAM_ATTR onPageButton() {
+        int64_t now = esp_timer_get_time();
+        if (now - lastPressUs < LCD_PAGE_DEBOUNCE_MS * 1000LL) return;
+        lastPressUs = now;
+        request.store(kLcdPageNext, std::memory_order_relaxed);
+        signalEventFromISR(EV_LCD_UPDATE);
+    }
+#endif
+} // namespace
+
+/* ====== Public Functions ====== */
+
+const char* lcdPageName(uint8_t p) {
+    return p < LCD_PAGE_COUNT ? kPageNames[p] : "?";
+}
+
+void lcdPagesInit() {
+    for (Spark& s : sparks) sparkReset(s);
+    pageShownMs = millis();
+#if LCD_PAGE_BUTTON_PIN >= 0
+    pinMode(LCD_PAGE_BUTTON_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(LCD_PAGE_BUTTON_PIN), onPageButton, FALLING);
+#endif
+}
+
+void lcdPagesSample(float tC, float rh) {
+    if (isnan(tC) || isnan(rh)) return;
+    uint32_t now = millis();
+    if (sparks[0].n == 0) columnStartMs = now;   // First reading of a column
+
+    sparks[0].sum += tC;
+    sparks[0].n++;
+    sparks[1].sum += rh;
+    sparks[1].n++;
+
+    if (now - columnStartMs >= LCD_SPARK_PERIOD_MS) {
+        for (Spark& s : sparks) sparkCommit(s);
+    }
+}
+
+void lcdPageRequest(int p) {
+    if (p != kLcdPageNext && (p < 0 || p >= LCD_PAGE_COUNT)) return;
+    request.store((int8_t)p, std::memory_order_relaxed);
+    signalEvent(EV_LCD_UPDATE);
+}
+
+bool lcdPageAdvance(uint32_t nowMs) {
+    int8_t req = request.exchange(kNoRequest, std::memory_order_relaxed);
+    uint8_t next = page;
+    if (req == kLcdPageNext) next = (page + 1) % LCD_PAGE_COUNT;
+    else if (req >= 0) next = (uint8_t)req;
+    else if (LCD_PAGE_ROTATE_MS > 0 && nowMs - pageShownMs >= LCD_PAGE_ROTATE_MS) next = (page + 1) % LCD_PAGE_COUNT;
+    else return false;
+
+    // A request restarts the rotation timer, so the chosen page stays up
+    pageShownMs = nowMs;
+    bool changed = next != page;
+    page = next;
+    return changed;
+}
+
+uint32_t lcdPageRotateIn(uint32_t nowMs) {
+    if (LCD_PAGE_ROTATE_MS == 0) return kWaitForever;
+    uint32_t shown = nowMs - pageShownMs;
+    return shown < LCD_PAGE_ROTATE_MS ? LCD_PAGE_ROTATE_MS - shown : 0;
+}
+
+uint8_t lcdPageCurrent() {
+    return page;
+}
+
+void lcdPageRender(uint8_t p) {
+    if (p < LCD_PAGE_COUNT) kPageRender[p]();
+}
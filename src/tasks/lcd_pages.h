@@ -0,0 +1,89 @@
+/**
+ * @file lcd_pages.h
+ * @brief LCD Pages - Rotating / button-selected LCD layouts
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * The LCD task draws one page at a time into the LCD shadow:
+ *
+ *   Page    Row 0                      Row 1
+ *   SENSOR  T:25.5C H:55%              T:NORM H:OK
+ *   TREND   T▁▂▄▆ 25.5C (sparkline)    H▆▄▃▃ 55% (sparkline)
+ *   ML      TinyML: 0.123              Stat:   0.045
+ *   NET     AP 192.168.4.1             SSID
+ *
+ * Pages advance every LCD_PAGE_ROTATE_MS, on a press of the page button
+ * (LCD_PAGE_BUTTON_PIN) or from POST /lcd/page.
+ *
+ * Each sparkline is four CGRAM glyphs of five one-pixel columns (20
+ * columns, one per LCD_SPARK_PERIOD_MS, averaged over the readings). A new
+ * reading only redraws the column in progress, so the shadow re-uploads
+ * one glyph. When the newest glyph is full, the oldest glyph's slot is
+ * reused for the next columns and the cells are renumbered: the other
+ * glyphs are not uploaded again. The vertical scale follows the window
+ * in 0.5 °C / 2 % steps; a new scale redraws the whole sparkline.
+ */
+
+#ifndef LCD_PAGES_H
+#define LCD_PAGES_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief LCD pages, in rotation order
+ */
+enum LcdPage : uint8_t {
+    LCD_PAGE_SENSOR = 0,
+    LCD_PAGE_TREND,
+    LCD_PAGE_ML,
+    LCD_PAGE_NET,
+    LCD_PAGE_COUNT
+};
+
+/// lcdPageRequest() argument: the page after the current one
+constexpr int kLcdPageNext = -1;
+
+/**
+ * @brief Page name ("sensor", "trend", "ml", "net")
+ */
+const char* lcdPageName(uint8_t page);
+
+/**
+ * @brief Attach the page button interrupt
+ */
+void lcdPagesInit();
+
+/**
+ * @brief Add a sensor reading to the sparkline history
+ */
+void lcdPagesSample(float tC, float rh);
+
+/**
+ * @brief Ask the LCD task to show a page (web; wakes the LCD task)
+ * @param page LcdPage or kLcdPageNext
+ */
+void lcdPageRequest(int page);
+
+/**
+ * @brief Apply a pending request, or rotate when the timer is due
+ * @return true when the page changed
+ */
+bool lcdPageAdvance(uint32_t nowMs);
+
+/**
+ * @brief Time until the next rotation, kWaitForever when rotation is off
+ */
+uint32_t lcdPageRotateIn(uint32_t nowMs);
+
+/**
+ * @brief Page currently shown
+ */
+uint8_t lcdPageCurrent();
+
+/**
+ * @brief Draw a page into the LCD shadow (rows and glyphs)
+ */
+void lcdPageRender(uint8_t page);
+
+#endif // LCD_PAGES_H
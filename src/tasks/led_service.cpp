@@ -0,0 +1,126 @@
+/**
+ * @file led_service.cpp
+ * @brief LED Service - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "led_service.h"
+#include "../hardware/neo_compositor.h"
+#include "freertos/FreeRTOS.h"
+#include <atomic>
+
+uint32_t ledServiceRamSaved() {
+    if (!LED_SERVICE || EXECUTOR_MODE) return 0;
+    return TASK_NEO_HUM_STACK_SIZE + TASK_NEO_UI_STACK_SIZE - TASK_LEDS_STACK_SIZE + sizeof(StaticTask_t);
+}
+
+#if LED_SERVICE
+
+/* ====== Local State ====== */
+
+namespace {
+    /**
+     * @brief Layer table (indexed by LedLayer)
+     */
+    const struct {
+        NeoStripId strip;
+        ExecEvent request;                ///< Event that requests a repaint
+        void (*init)();
+        uint32_t (*step)(bool requested);
+    } kLayerTable[LED_LAYER_COUNT] = {
+        { NEO_STRIP_HUM, EV_HUM_CHANGED, neoHumInit, neoHumStep },
+        { NEO_STRIP_UI,  EV_UI_MODE,     neoUiInit,  neoUiStep },
+    };
+
+    /**
+     * @brief Timer of one layer
+     */
+    struct LayerTimer {
+        bool timed;                       ///< false = waits for its request only
+        uint32_t dueMs;                   ///< millis() of the next run
+    };
+
+    LayerTimer timers[LED_LAYER_COUNT];
+    std::atomic<uint8_t> requests{0};     ///< Bit per LedLayer
+
+    /**
+     * @brief Run one layer and time its render
+     */
+    void runLayer(int i, bool requested) {
+        NeoStripId strip = kLayerTable[i].strip;
+        neoRenderBegin(strip);
+        uint32_t next = kLayerTable[i].step(requested);
+        neoRenderEnd(strip);
+
+        timers[i].timed = next != kWaitForever;
+        if (timers[i].timed) timers[i].dueMs = millis() + next;
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void ledServicePost(ExecEvent ev) {
+    for (int i = 0; i < LED_LAYER_COUNT; i++) {
+        if (kLayerTable[i].request == ev) requests.fetch_or((uint8_t)(1u << i), std::memory_order_relaxed);
+    }
+}
+
+void ledServiceInit() {
+    uint32_t now = millis();
+    for (int i = 0; i < LED_LAYER_COUNT; i++) {
+        kLayerTable[i].init();
+        timers[i] = { true, now };        // First pass: every layer paints once
+    }
+    timers[LED_LAYER_HUM].timed = false;  // Humidity waits for Task 1's first reading
+
+    if (EXECUTOR_MODE) {
+        Serial.printf("[LEDS] LED service: %d outputs as one executor job\n", LED_LAYER_COUNT);
+    } else {
+        Serial.printf("[LEDS] LED service: %d outputs, one task (%u B stack) instead of NEO_H + NEO_UI (%u B) → %u B saved\n",
+                      LED_LAYER_COUNT, (unsigned)TASK_LEDS_STACK_SIZE,
+                      (unsigned)(TASK_NEO_HUM_STACK_SIZE + TASK_NEO_UI_STACK_SIZE), (unsigned)ledServiceRamSaved());
+    }
+}
+
+/**
+ * @brief Run requested and due layers
+ * @return Time until the earliest layer timer, kWaitForever if none
+ */
+uint32_t ledServiceStep(bool signaled) {
+    uint8_t req = requests.exchange(0, std::memory_order_relaxed);
+    uint32_t now = millis();
+    for (int i = 0; i < LED_LAYER_COUNT; i++) {
+        bool requested = req & (1u << i);
+        bool due = timers[i].timed && (int32_t)(now - timers[i].dueMs) >= 0;
+        if (requested || due) runLayer(i, requested);
+    }
+    // A new brightness level (possibly set by the pass above) leaves strips
+    // stale: re-send their last frame through the new table
+    for (const auto& layer : kLayerTable) {
+        if (neoStale(layer.strip)) neoPresent(layer.strip);
+    }
+
+    now = millis();
+    uint32_t wait = kWaitForever;
+    for (const LayerTimer& t : timers) {
+        if (!t.timed) continue;
+        int32_t left = (int32_t)(t.dueMs - now);
+        uint32_t ms = left > 0 ? (uint32_t)left : 0;
+        if (ms < wait) wait = ms;
+    }
+    return wait;
+}
+
+void task_led_service(void* pv) {
+    ledServiceInit();
+    runAsTask(ledServiceStep, EV_HUM_CHANGED);   // EV_UI_MODE shares its semaphore
+}
+
+#else
+
+void task_led_service(void* pv) {
+    vTaskDelete(nullptr);
+}
+
+#endif // LED_SERVICE
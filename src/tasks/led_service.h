@@ -0,0 +1,64 @@
+/**
+ * @file led_service.h
+ * @brief LED Service - One task for every addressable LED output
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * With LED_SERVICE=1 the humidity pixel and the UI bar are rendered by a
+ * single LEDS task (one stack, one TCB) instead of NEO_H and NEO_UI. Each
+ * output is a layer with its own step function (task2_led_neopixel.cpp):
+ *
+ *   Layer  Request                          Timer
+ *   HUM    signalEvent(EV_HUM_CHANGED)      none (event-driven)
+ *   UI     signalEvent(EV_UI_MODE)          frame period / next keyframe
+ *
+ * signalEvent() sets the layer's request bit and wakes the service (both
+ * events share its semaphore, or its executor job). A step runs the
+ * requested layers and the layers whose timer is due, then sleeps until
+ * the earliest remaining timer.
+ *
+ * A layer whose strip went stale (new brightness level, see
+ * neo_compositor.h) is re-sent from its last frame without rendering.
+ *
+ * Render time (step minus the compositor's transmit time) is recorded per
+ * strip and served with the transmit times by GET /neopixel.
+ */
+
+#ifndef LED_SERVICE_H
+#define LED_SERVICE_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+#include "executor.h"
+
+/**
+ * @brief Outputs owned by the service (one per NeoPixel strip)
+ */
+enum LedLayer : uint8_t {
+    LED_LAYER_HUM = 0,
+    LED_LAYER_UI,
+    LED_LAYER_COUNT
+};
+
+#if LED_SERVICE
+/**
+ * @brief Set the request bit of the layer fed by ev (called by signalEvent)
+ */
+void ledServicePost(ExecEvent ev);
+#else
+inline void ledServicePost(ExecEvent) {}
+#endif
+
+/**
+ * @brief Bytes of stack and TCB saved against one task per strip
+ * @return 0 when LED_SERVICE=0 or in EXECUTOR_MODE (no per-strip tasks)
+ */
+uint32_t ledServiceRamSaved();
+
+/**
+ * @brief LED service task (LED_SERVICE=1, EXECUTOR_MODE=0)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_led_service(void* pv);
+
+#endif // LED_SERVICE_H
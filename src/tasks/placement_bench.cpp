@@ -0,0 +1,152 @@
+/**
+ * @file placement_bench.cpp
+ * @brief Placement Benchmark - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ */
+
+#include "placement_bench.h"
+#include "../config/config.h"
+
+#if TASK_PLACEMENT_BENCH || LATENCY_BENCH  // The latency benchmark reuses the burner
+
+#include <algorithm>
+#include <WiFi.h>
+#include "esp_timer.h"
+
+/* ====== Local State ====== */
+
+namespace
+{
+    volatile bool benchDone = false;   ///< Set when the report has been printed
+
+    // Sensor period statistics (written by the DHT20 task only)
+    int64_t lastTickUs = 0;
+    uint32_t periods = 0;
+    double periodSum = 0.0;
+    double periodSumSq = 0.0;
+    int64_t periodMin = INT64_MAX;
+    int64_t periodMax = 0;
+
+    uint32_t httpUs[TASK_BENCH_HTTP_MAX_SAMPLES];  ///< Round-trip latencies
+} // namespace
+
+/* ====== Sensor Jitter ====== */
+
+void placementBenchSensorTick()
+{
+    int64_t now = esp_timer_get_time();
+    if (lastTickUs != 0 && !benchDone)
+    {
+        int64_t p = now - lastTickUs;
+        periods++;
+        periodSum += p;
+        periodSumSq += (double)p * p;
+        if (p < periodMin) periodMin = p;
+        if (p > periodMax) periodMax = p;
+    }
+    lastTickUs = now;
+}
+
+/* ====== Load Generator ====== */
+
+void task_bench_load(void* pv)
+{
+    while (!benchDone)
+    {
+        int64_t until = esp_timer_get_time() + TASK_BENCH_LOAD_BUSY_MS * 1000LL;
+        while (esp_timer_get_time() < until) {}
+        vTaskDelay(pdMS_TO_TICKS(TASK_BENCH_LOAD_IDLE_MS));
+    }
+    vTaskDelete(nullptr);
+}
+
+/* ====== HTTP Latency ====== */
+
+/**
+ * @brief Our own address: the station IP once joined, else the AP IP
+ */
+static IPAddress selfIP()
+{
+    return (WiFi.getMode() & WIFI_MODE_STA) ? WiFi.localIP() : WiFi.softAPIP();
+}
+
+/**
+ * @brief One GET /state against our own address
+ * @return Round trip in microseconds (connect → last byte), 0 on failure
+ */
+static uint32_t httpRoundTrip()
+{
+    WiFiClient client;
+    IPAddress ip = selfIP();
+    int64_t t0 = esp_timer_get_time();
+    if (!client.connect(ip, 80)) return 0;
+
+    client.print("GET /state HTTP/1.1\r\nHost: " + ip.toString() + "\r\nConnection: close\r\n\r\n");
+    int64_t deadline = t0 + 2000000;  // 2 s
+    while (client.connected() && esp_timer_get_time() < deadline)
+    {
+        while (client.available()) client.read();
+        vTaskDelay(1);
+    }
+    bool complete = !client.connected();
+    client.stop();
+    return complete ? (uint32_t)(esp_timer_get_time() - t0) : 0;
+}
+
+/**
+ * @brief Print the report for the active placement profile
+ */
+static void printReport(int n, uint32_t failures)
+{
+    Serial.printf("\n[PLACE] ===== Placement benchmark, profile %d =====\n", TASK_PLACEMENT_PROFILE);
+
+    if (periods > 1)
+    {
+        double mean = periodSum / periods;
+        double var = periodSumSq / periods - mean * mean;
+        Serial.printf("[PLACE] Sensor period: %u samples, mean %.0f us, std %.0f us, min %lld us, max %lld us (p-p jitter %lld us)\n",
+                      (unsigned)periods, mean, var > 0 ? sqrt(var) : 0.0,
+                      periodMin, periodMax, periodMax - periodMin);
+    }
+    else
+    {
+        Serial.println("[PLACE] Sensor period: no samples");
+    }
+
+    if (n > 0)
+    {
+        std::sort(httpUs, httpUs + n);
+        Serial.printf("[PLACE] HTTP latency: %d ok, %u failed, p50=%u p90=%u p99=%u max=%u us\n",
+                      n, (unsigned)failures, (unsigned)httpUs[n * 50 / 100], (unsigned)httpUs[n * 90 / 100],
+                      (unsigned)httpUs[n * 99 / 100], (unsigned)httpUs[n - 1]);
+    }
+    else
+    {
+        Serial.printf("[PLACE] HTTP latency: no successful requests (%u failed)\n", (unsigned)failures);
+    }
+}
+
+void task_bench_http(void* pv)
+{
+    // Let the web server and sensor settle before measuring
+    vTaskDelay(pdMS_TO_TICKS(3000));
+    Serial.printf("[PLACE] Measuring for %d s under load\n", TASK_BENCH_DURATION_MS / 1000);
+
+    int n = 0;
+    uint32_t failures = 0;
+    uint32_t start = millis();
+    while (millis() - start < TASK_BENCH_DURATION_MS)
+    {
+        uint32_t us = httpRoundTrip();
+        if (us == 0) failures++;
+        else if (n < TASK_BENCH_HTTP_MAX_SAMPLES) httpUs[n++] = us;
+        vTaskDelay(pdMS_TO_TICKS(TASK_BENCH_HTTP_PERIOD_MS));
+    }
+
+    benchDone = true;
+    printReport(n, failures);
+    vTaskDelete(nullptr);
+}
+
+#endif // TASK_PLACEMENT_BENCH || LATENCY_BENCH
@@ -0,0 +1,40 @@
+/**
+ * @file placement_bench.h
+ * @brief Placement Benchmark - Sensor jitter and HTTP latency under load
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Compares task placement profiles (TASK_PLACEMENT_PROFILE) by measuring,
+ * while both cores carry an ~80% CPU burner:
+ * - DHT20 task period: mean, standard deviation, min/max (jitter)
+ * - HTTP latency: loopback GET /state round trip, p50 / p90 / p99 / max
+ *
+ * The report is printed once after TASK_BENCH_DURATION_MS, then the load
+ * and client tasks delete themselves.
+ *
+ * @note Built by the [env:bench_place_float|split|packed] environments
+ */
+
+#ifndef PLACEMENT_BENCH_H
+#define PLACEMENT_BENCH_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Record one DHT20 loop iteration (called at the top of the loop)
+ */
+void placementBenchSensorTick();
+
+/**
+ * @brief CPU burner (busy TASK_BENCH_LOAD_BUSY_MS, sleep TASK_BENCH_LOAD_IDLE_MS)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_bench_load(void* pv);
+
+/**
+ * @brief Loopback HTTP client; prints the report when the window ends
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_bench_http(void* pv);
+
+#endif // PLACEMENT_BENCH_H
@@ -0,0 +1,287 @@
+/**
+ * @file power_manager.cpp
+ * @brief Power Manager - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Lock hold times are accumulated here (esp_pm only keeps them with
+ * CONFIG_PM_PROFILING, which the prebuilt framework does not set). Idle
+ * time is the IDLE tasks' CPU share; with light sleep enabled the time
+ * spent asleep is charged to IDLE, so it covers both idle states.
+ */
+
+#include "power_manager.h"
+
+#if POWER_MGMT_ENABLED
+
+#include "task_monitor.h"
+#include <WiFi.h>
+#include "esp_pm.h"
+#include "esp_idf_version.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/* ====== Local State ====== */
+
+namespace {
+    /**
+     * @brief Lock table (indexed by PmLockId)
+     */
+    const struct {
+        const char* name;
+        esp_pm_lock_type_t type;
+    } kLockTable[PM_LOCK_COUNT] = {
+        { "i2c",      ESP_PM_APB_FREQ_MAX },   // Bus clock fixed, no light sleep mid-transfer
+        { "neopixel", ESP_PM_CPU_FREQ_MAX },   // WS2812 bit timing needs a fixed clock
+        { "wifi",     ESP_PM_CPU_FREQ_MAX },   // Serve requests at full speed
+    };
+
+    /**
+     * @brief Hold-time accounting for one lock
+     */
+    struct LockState {
+        esp_pm_lock_handle_t handle;
+        uint16_t holders;
+        int64_t sinceUs;                  ///< First holder's acquire time
+        int64_t heldUs;                   ///< Held time in the current window
+        uint32_t acquires;
+    };
+
+    LockState locks[PM_LOCK_COUNT];
+    uint16_t maxHolders = 0;              ///< Holders of any CPU-max lock
+    int64_t maxSinceUs = 0;
+    int64_t maxHeldUs = 0;
+
+    // Sensor period (written by the DHT20 job)
+    int64_t lastTickUs = 0;
+    int64_t periodMinUs = INT64_MAX;
+    int64_t periodMaxUs = 0;
+    uint32_t periods = 0;
+
+    portMUX_TYPE pmMux = portMUX_INITIALIZER_UNLOCKED;
+    bool configured = false;
+
+    PowerStat last;
+    bool haveReport = false;
+    uint32_t jitterViolations = 0;
+
+    const char* sleepState() {
+        if (!configured) return "unavailable";
+        if (!PM_LIGHT_SLEEP) return "off";
+#if !CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        return "unavailable";             // Framework built without tickless idle
+#else
+        if (WiFi.getMode() & WIFI_MODE_AP) return "blocked by softAP";
+        return "enabled";
+#endif
+    }
+
+    /**
+     * @brief Average IDLE-task share of both cores over the monitor's 10 s window
+     */
+    float idleSharePct() {
+        static TaskStat stats[TASK_MON_MAX_TASKS];
+        int n = taskMonitorSnapshot(stats, TASK_MON_MAX_TASKS);
+        float sum = 0.0f;
+        int found = 0;
+        for (int i = 0; i < n; i++) {
+            if (strncmp(stats[i].name, "IDLE", 4) != 0) continue;
+            if (isnan(stats[i].cpu10s)) return NAN;
+            sum += stats[i].cpu10s;
+            found++;
+        }
+        return found > 0 ? sum / portNUM_PROCESSORS : NAN;
+    }
+
+    /**
+     * @brief Close the current window and build the report
+     */
+    void buildReport(PowerStat& r, int64_t windowUs) {
+        int64_t now = esp_timer_get_time();
+        int64_t held[PM_LOCK_COUNT];
+        int64_t maxUs;
+        int64_t pMin, pMax;
+
+        portENTER_CRITICAL(&pmMux);
+        for (int i = 0; i < PM_LOCK_COUNT; i++) {
+            LockState& l = locks[i];
+            held[i] = l.heldUs + (l.holders ? now - l.sinceUs : 0);
+            r.lockAcquires[i] = l.acquires;
+            l.heldUs = 0;
+            l.sinceUs = now;
+            l.acquires = 0;
+        }
+        maxUs = maxHeldUs + (maxHolders ? now - maxSinceUs : 0);
+        maxHeldUs = 0;
+        maxSinceUs = now;
+        r.periods = periods;
+        pMin = periodMinUs;
+        pMax = periodMaxUs;
+        periods = 0;
+        periodMinUs = INT64_MAX;
+        periodMaxUs = 0;
+        portEXIT_CRITICAL(&pmMux);
+
+        r.active = configured;
+        r.sleepState = sleepState();
+        r.maxMhz = PM_MAX_FREQ_MHZ;
+        r.minMhz = PM_MIN_FREQ_MHZ;
+        r.windowMs = (uint32_t)(windowUs / 1000);
+        for (int i = 0; i < PM_LOCK_COUNT; i++) r.lockPct[i] = 100.0f * held[i] / windowUs;
+
+        // Residency: CPU max, then the rest of the busy time at min frequency
+        float maxF = (float)maxUs / windowUs;
+        float idleF = idleSharePct() / 100.0f;
+        r.maxPct = 100.0f * maxF;
+        if (isnan(idleF)) {
+            r.minPct = NAN;
+            r.idlePct = NAN;
+            r.estMa = NAN;
+        } else {
+            float minF = max(0.0f, 1.0f - idleF - maxF);
+            idleF = max(0.0f, 1.0f - maxF - minF);
+            bool sleeping = strcmp(r.sleepState, "enabled") == 0;
+            bool ap = WiFi.getMode() & WIFI_MODE_AP;
+            r.minPct = 100.0f * minF;
+            r.idlePct = 100.0f * idleF;
+            r.estMa = maxF * PM_CURRENT_MAX_MA + minF * PM_CURRENT_MIN_MA
+                    + idleF * (sleeping ? PM_CURRENT_SLEEP_MA : PM_CURRENT_IDLE_MA)
+                    + (ap ? PM_CURRENT_WIFI_MA : 0.0f);
+        }
+
+        r.jitterUs = r.periods > 1 ? (uint32_t)(pMax - pMin) : 0;
+        r.jitterBoundUs = PM_JITTER_BOUND_US;
+        if (r.jitterUs > PM_JITTER_BOUND_US) jitterViolations++;
+        r.jitterViolations = jitterViolations;
+    }
+
+    void printReport(const PowerStat& r) {
+        Serial.printf("[PM] %us: max %.1f%% | min %.1f%% | idle %.1f%% (light sleep %s) → ~%.1f mA\n",
+                      (unsigned)(r.windowMs / 1000), r.maxPct, r.minPct, r.idlePct, r.sleepState, r.estMa);
+        Serial.printf("[PM] locks: i2c %.2f%% (%u) neopixel %.2f%% (%u) wifi %.2f%% (%u) | DHT20 jitter %u us %s %u us\n",
+                      r.lockPct[PM_LOCK_I2C], (unsigned)r.lockAcquires[PM_LOCK_I2C],
+                      r.lockPct[PM_LOCK_NEOPIXEL], (unsigned)r.lockAcquires[PM_LOCK_NEOPIXEL],
+                      r.lockPct[PM_LOCK_WIFI], (unsigned)r.lockAcquires[PM_LOCK_WIFI],
+                      (unsigned)r.jitterUs, r.jitterUs > r.jitterBoundUs ? "✗ >" : "✓ <=",
+                      (unsigned)r.jitterBoundUs);
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void powerInit() {
+    for (int i = 0; i < PM_LOCK_COUNT; i++) {
+        if (esp_pm_lock_create(kLockTable[i].type, 0, kLockTable[i].name, &locks[i].handle) != ESP_OK) {
+            locks[i].handle = nullptr;
+        }
+    }
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    esp_pm_config_t cfg = {};
+#else
+    esp_pm_config_esp32s3_t cfg = {};
+#endif
+    cfg.max_freq_mhz = PM_MAX_FREQ_MHZ;
+    cfg.min_freq_mhz = PM_MIN_FREQ_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    cfg.light_sleep_enable = PM_LIGHT_SLEEP;
+#endif
+
+    esp_err_t err = esp_pm_configure(&cfg);
+    configured = err == ESP_OK;
+    if (configured) {
+        Serial.printf("[PM] ✓ DFS %d-%d MHz, light sleep %s\n", PM_MIN_FREQ_MHZ, PM_MAX_FREQ_MHZ, sleepState());
+    } else {
+        Serial.printf("[PM] ✗ esp_pm_configure failed (%s) - framework built without CONFIG_PM_ENABLE?\n",
+                      esp_err_to_name(err));
+    }
+}
+
+void pmAcquire(PmLockId id) {
+    LockState& l = locks[id];
+    if (l.handle) esp_pm_lock_acquire(l.handle);
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&pmMux);
+    if (l.holders++ == 0) l.sinceUs = now;
+    l.acquires++;
+    if (kLockTable[id].type == ESP_PM_CPU_FREQ_MAX && maxHolders++ == 0) maxSinceUs = now;
+    portEXIT_CRITICAL(&pmMux);
+}
+
+void pmRelease(PmLockId id) {
+    LockState& l = locks[id];
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL_SAFE(&pmMux);
+    if (l.holders > 0 && --l.holders == 0) l.heldUs += now - l.sinceUs;
+    if (kLockTable[id].type == ESP_PM_CPU_FREQ_MAX && maxHolders > 0 && --maxHolders == 0) {
+        maxHeldUs += now - maxSinceUs;
+    }
+    portEXIT_CRITICAL_SAFE(&pmMux);
+
+    if (l.handle) esp_pm_lock_release(l.handle);
+}
+
+void powerSensorTick() {
+    int64_t now = esp_timer_get_time();
+    if (lastTickUs != 0) {
+        int64_t p = now - lastTickUs;
+        portENTER_CRITICAL(&pmMux);
+        if (p < periodMinUs) periodMinUs = p;
+        if (p > periodMaxUs) periodMaxUs = p;
+        periods++;
+        portEXIT_CRITICAL(&pmMux);
+    }
+    lastTickUs = now;
+}
+
+bool powerSnapshot(PowerStat& out) {
+    portENTER_CRITICAL(&pmMux);
+    bool ok = haveReport;
+    if (ok) out = last;
+    portEXIT_CRITICAL(&pmMux);
+    return ok;
+}
+
+const char* pmLockName(PmLockId id) {
+    return id < PM_LOCK_COUNT ? kLockTable[id].name : "?";
+}
+
+void task_power(void* pv) {
+    int64_t windowStart = esp_timer_get_time();
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(PM_REPORT_MS));
+
+        int64_t now = esp_timer_get_time();
+        PowerStat r;
+        buildReport(r, now - windowStart);
+        windowStart = now;
+
+        portENTER_CRITICAL(&pmMux);
+        last = r;
+        haveReport = true;
+        portEXIT_CRITICAL(&pmMux);
+
+        printReport(r);
+    }
+}
+
+#else
+
+void powerInit() {}
+
+bool powerSnapshot(PowerStat& out) {
+    return false;
+}
+
+const char* pmLockName(PmLockId id) {
+    static const char* const kNames[PM_LOCK_COUNT] = { "i2c", "neopixel", "wifi" };
+    return id < PM_LOCK_COUNT ? kNames[id] : "?";
+}
+
+void task_power(void* pv) {
+    vTaskDelete(nullptr);
+}
+
+#endif // POWER_MGMT_ENABLED
@@ -0,0 +1,106 @@
+/**
+ * @file power_manager.h
+ * @brief Power Manager - Dynamic frequency scaling, automatic light sleep and PM locks
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * With POWER_MGMT_ENABLED the CPU runs at PM_MIN_FREQ_MHZ and, when the
+ * framework has tickless idle, light-sleeps whenever every task is blocked.
+ * PM locks are held only around the work that needs the clocks:
+ *
+ *   PM_LOCK_I2C       APB max (no light sleep)   DHT20 read, LCD refresh
+ *   PM_LOCK_NEOPIXEL  CPU max                    strip.show() (cycle-timed)
+ *   PM_LOCK_WIFI      CPU max                    one HTTP route handler
+ *
+ * The WiFi driver takes its own locks for the radio; in AP mode it keeps
+ * light sleep blocked for as long as the AP is up, so only DFS applies.
+ *
+ * A PWR task reports every PM_REPORT_MS:
+ * - Residency: CPU max (a CPU-max lock held), active at min frequency,
+ *   idle (light sleep when allowed, otherwise WFI at min frequency);
+ *   idle share comes from the task monitor's 10 s CPU window
+ * - Estimated current from the PM_CURRENT_*_MA figures
+ * - Sensor period jitter (peak-to-peak) against PM_JITTER_BOUND_US
+ *
+ * @note Served as JSON by GET /power
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief PM locks taken by the firmware
+ */
+enum PmLockId : uint8_t {
+    PM_LOCK_I2C = 0,
+    PM_LOCK_NEOPIXEL,
+    PM_LOCK_WIFI,
+    PM_LOCK_COUNT
+};
+
+/**
+ * @brief Latest report (copied out by powerSnapshot)
+ */
+struct PowerStat {
+    bool active;                        ///< esp_pm_configure() succeeded
+    const char* sleepState;             ///< "enabled", "blocked by softAP", "off", "unavailable"
+    uint16_t maxMhz;
+    uint16_t minMhz;
+    uint32_t windowMs;                  ///< Report window
+    float maxPct;                       ///< Residency: CPU max lock held
+    float minPct;                       ///< Residency: running at min frequency
+    float idlePct;                      ///< Residency: idle / light sleep (NAN = no run-time stats)
+    float estMa;                        ///< Estimated average current (NAN = unknown)
+    float lockPct[PM_LOCK_COUNT];       ///< Share of the window each lock was held
+    uint32_t lockAcquires[PM_LOCK_COUNT];
+    uint32_t periods;                   ///< Sensor periods in the window
+    uint32_t jitterUs;                  ///< Sensor period max - min in the window
+    uint32_t jitterBoundUs;
+    uint32_t jitterViolations;          ///< Windows over the bound since boot
+};
+
+/**
+ * @brief Configure DFS / light sleep and create the PM locks
+ * @note Call once from setup() before createAllTasks()
+ */
+void powerInit();
+
+#if POWER_MGMT_ENABLED
+/**
+ * @brief Take / release a PM lock (nestable, any task)
+ * @note pmRelease() may also be called from an ISR (RMT TX end)
+ */
+void pmAcquire(PmLockId id);
+void pmRelease(PmLockId id);
+
+/**
+ * @brief Record one DHT20 activation (called at the top of sensorStep)
+ */
+void powerSensorTick();
+#else
+inline void pmAcquire(PmLockId) {}
+inline void pmRelease(PmLockId) {}
+inline void powerSensorTick() {}
+#endif
+
+/**
+ * @brief Copy the latest report
+ * @return false when power management is disabled or no report exists yet
+ */
+bool powerSnapshot(PowerStat& out);
+
+/**
+ * @brief Lock name for reports
+ */
+const char* pmLockName(PmLockId id);
+
+/**
+ * @brief FreeRTOS task that computes and prints the report
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_power(void* pv);
+
+#endif // POWER_MANAGER_H
@@ -11,94 +11,144 @@
 #include "../config/config.h"
 #include "../config/system_types.h"
 #include "../hardware/hardware_manager.h"
+#include "../ml/stat_anomaly.h"
+#include "placement_bench.h"
+#include "executor.h"
+#include "latency_bench.h"
+#include "power_manager.h"
+#include "deadline_monitor.h"
+#include "deferred_log.h"
+#include "trace_recorder.h"
+
+/* ====== Job State ====== */
+
+namespace {
+    TempBand lastT = TempBand::NORMAL;
+    HumBand  lastH = HumBand::COMFORT;
+    bool firstReading = true;  // Flag for first reading
+}
+
+/* ====== Job Functions ====== */
 
 /**
- * @brief Task 1 Handler - DHT20 Sensor Reading
- * 
- * Responsibilities:
- * - Read DHT20 sensor every 500ms
- * - Classify temperature into bands (COLD, NORMAL, HOT, CRITICAL)
- * - Classify humidity into bands (DRY, COMFORT, HUMID, WET)
- * - Signal Task 2 (LED) when temperature band changes via semBandChanged
- * - Signal Task 3 (NeoPixel) when humidity band changes via semHumChanged
- * - Always signal LCD update via semLcdUpdate
- * 
- * @param pv Unused parameter (FreeRTOS requirement)
+ * @brief One-time sensor setup (stabilizing reads)
  */
-void task_read_dht20(void* pv) {
+void sensorInit() {
     // Initial readings to stabilize sensor
     dht.read(); 
     vTaskDelay(pdMS_TO_TICKS(100)); 
     dht.read();
 
-    TempBand lastT = TempBand::NORMAL;
-    HumBand  lastH = HumBand::COMFORT;
-    bool firstReading = true;  // Flag for first reading
-
     Serial.println("[TASK1] DHT20 sensor task started");
     Serial.println("[TASK1] Will signal:");
     Serial.println("        - semBandChanged → Task 2 (LED)");
     Serial.println("        - semHumChanged → Task 3 (NeoPixel)");
     Serial.println("        - semLcdUpdate → Task 5 (LCD)");
+}
+
+/**
+ * @brief One sensor cycle: read, classify, signal consumers
+ * @param signaled Unused (periodic job)
+ * @return Delay until the next reading (DHT_READ_INTERVAL_MS)
+ */
+uint32_t sensorStep(bool signaled) {
+    deadlineBegin(DL_SENSOR);
+    powerSensorTick();
+#if TASK_PLACEMENT_BENCH
+    placementBenchSensorTick();  // Period jitter for the placement benchmark
+#endif
+
+    // Read sensor data
+    static const uint8_t kTraceDht = traceLabel("DHT20");
+    traceRecord(TRACE_I2C_BEGIN, kTraceDht);
+    pmAcquire(PM_LOCK_I2C);
+    dht.read();
+    pmRelease(PM_LOCK_I2C);
+    traceRecord(TRACE_I2C_END, kTraceDht);
+    latencySample();
+    float t = dht.getTemperature();
+    float h = dht.getHumidity();
+
+    // Update global state (shared with web server)
+    gLive.tC = t;
+    gLive.rh = h;
+    gLive.dht_last_ms = millis();
+    gLive.dht_runs++;
 
-    for (;;) {
-        // Read sensor data
-        dht.read();
-        float t = dht.getTemperature();
-        float h = dht.getHumidity();
-
-        // Update global state (shared with web server)
-        gLive.tC = t;
-        gLive.rh = h;
-        gLive.dht_last_ms = millis();
-        gLive.dht_runs++;
-
-        // Classify current readings
-        TempBand nowT = classifyTemp(t);
-        HumBand  nowH = classifyHum(h);
-
-        // SEMAPHORE SIGNALING: Temperature band change (or first reading)
-        if (nowT != lastT || firstReading) {
-            gLive.tBand = nowT;
-            xSemaphoreGive(semBandChanged);  // ← Signal Task 2 (LED)
-            gLive.giveTemp++;
-            lastT = nowT;
-            if (firstReading) {
-                Serial.printf("[TASK1] ✓ First reading: Temp=%s (%.1f°C) → semBandChanged given\n", 
-                              bandName(nowT), t);
-            } else {
-                Serial.printf("[TASK1] ✓ Temp band changed: %s (%.1f°C) → semBandChanged given\n", 
-                              bandName(nowT), t);
-            }
-            
-            // AUTO-RESET SOS MODE: If temperature drops from CRITICAL and SOS mode is active
-            if (lastT == TempBand::CRITICAL && nowT != TempBand::CRITICAL && gLive.uiMode == 3) {
-                gLive.uiMode = 1;  // Switch back to BAR mode (safe visual indicator)
-                Serial.println("[TASK1] ✓ Temperature safe → Auto-resetting SOS mode to BAR mode");
-            }
+    // Streaming anomaly baseline (O(1), runs on every reading)
+    uint32_t c0 = ESP.getCycleCount();
+    float statScore = statAnomalyUpdate(t, h);
+    gLive.stat_cycles = ESP.getCycleCount() - c0;
+    gLive.stat_score = statScore;
+
+    // Classify current readings
+    TempBand nowT = classifyTemp(t);
+    HumBand  nowH = classifyHum(h);
+
+    // SEMAPHORE SIGNALING: Temperature band change (or first reading)
+    if (nowT != lastT || firstReading) {
+        gLive.tBand = nowT;
+        signalEvent(EV_BAND_CHANGED);  // ← Signal Task 2 (LED)
+        gLive.giveTemp++;
+        lastT = nowT;
+        if (firstReading) {
+            DLOG_I("[TASK1] ✓ First reading: Temp=%s (%.1f°C) → semBandChanged given\n",
+                   bandName(nowT), t);
+        } else {
+            DLOG_I("[TASK1] ✓ Temp band changed: %s (%.1f°C) → semBandChanged given\n",
+                   bandName(nowT), t);
+        }
+        
+        // AUTO-RESET SOS MODE: If temperature drops from CRITICAL and SOS mode is active
+        if (lastT == TempBand::CRITICAL && nowT != TempBand::CRITICAL && gLive.uiMode == 3) {
+            gLive.uiMode = 1;  // Switch back to BAR mode (safe visual indicator)
+            signalEvent(EV_UI_MODE);
+            DLOG_I("[TASK1] ✓ Temperature safe → Auto-resetting SOS mode to BAR mode\n");
         }
+    }
 
-        // SEMAPHORE SIGNALING: Humidity band change (or first reading)
-        if (nowH != lastH || firstReading) {
-            gLive.hBand = nowH;
-            xSemaphoreGive(semHumChanged);  // ← Signal Task 3 (NeoPixel)
-            gLive.giveHum++;
-            lastH = nowH;
-            if (firstReading) {
-                Serial.printf("[TASK1] ✓ First reading: Hum=%s (%.1f%%) → semHumChanged given\n", 
-                              humName(nowH), h);
-            } else {
-                Serial.printf("[TASK1] ✓ Hum band changed: %s (%.1f%%) → semHumChanged given\n", 
-                              humName(nowH), h);
-            }
+    // SEMAPHORE SIGNALING: Humidity band change (or first reading)
+    if (nowH != lastH || firstReading) {
+        gLive.hBand = nowH;
+        signalEvent(EV_HUM_CHANGED);  // ← Signal Task 3 (NeoPixel)
+        gLive.giveHum++;
+        lastH = nowH;
+        if (firstReading) {
+            DLOG_I("[TASK1] ✓ First reading: Hum=%s (%.1f%%) → semHumChanged given\n",
+                   humName(nowH), h);
+        } else {
+            DLOG_I("[TASK1] ✓ Hum band changed: %s (%.1f%%) → semHumChanged given\n",
+                   humName(nowH), h);
         }
+    }
 
-        // SEMAPHORE SIGNALING: Always update LCD
-        xSemaphoreGive(semLcdUpdate);  // ← Signal Task 5 (LCD)
+    // SEMAPHORE SIGNALING: Always update LCD
+    signalEvent(EV_LCD_UPDATE);  // ← Signal Task 5 (LCD)
 
-        firstReading = false;  // Clear flag after first reading
+    firstReading = false;  // Clear flag after first reading
+    deadlineEnd(DL_SENSOR);
 
-        // Wait 500ms before next reading
-        vTaskDelay(pdMS_TO_TICKS(DHT_READ_INTERVAL_MS));
-    }
+    // Wait 500ms before next reading
+    return DHT_READ_INTERVAL_MS;
+}
+
+/**
+ * @brief Task 1 Handler - DHT20 Sensor Reading
+ * 
+ * Responsibilities:
+ * - Read DHT20 sensor every 500ms
+ * - Classify temperature into bands (COLD, NORMAL, HOT, CRITICAL)
+ * - Classify humidity into bands (DRY, COMFORT, HUMID, WET)
+ * - Signal Task 2 (LED) when temperature band changes via semBandChanged
+ * - Signal Task 3 (NeoPixel) when humidity band changes via semHumChanged
+ * - Always signal LCD update via semLcdUpdate
+ * - Feed the streaming statistical anomaly detector
+ * 
+ * @param pv Unused parameter (FreeRTOS requirement)
+ * @note The body is sensorStep(); with EXECUTOR_MODE it runs in the
+ *       cooperative executor instead of this task
+ */
+void task_read_dht20(void* pv) {
+    sensorInit();
+    runAsTask(sensorStep, EV_NONE);
 }
@@ -11,6 +11,199 @@
 #include "../config/config.h"
 #include "../config/system_types.h"
 #include "../hardware/hardware_manager.h"
+#include "../hardware/neo_compositor.h"
+#include "../hardware/neo_effects.h"
+#include "../hardware/neo_pattern.h"
+#include "executor.h"
+#include "latency_bench.h"
+#include "deadline_monitor.h"
+#include "deferred_log.h"
+#include "esp_timer.h"
+#include <atomic>
+
+/* ====== Task 2: LED ====== */
+
+namespace {
+    bool ledStarted = false;    ///< First semBandChanged received
+    uint64_t edgeLateSumUs = 0; ///< Sum of blink edge lateness (for the mean)
+
+    /**
+     * @brief Account one blink edge that was due at dueUs
+     */
+    void recordEdge(int64_t dueUs, int64_t nowUs) {
+        uint32_t late = nowUs > dueUs ? (uint32_t)(nowUs - dueUs) : 0;
+        edgeLateSumUs += late;
+        gLive.led_edges++;
+        if (late > gLive.led_jitter_max_us) gLive.led_jitter_max_us = late;
+        gLive.led_jitter_avg_us = (uint32_t)(edgeLateSumUs / gLive.led_edges);
+    }
+
+#if LED_BLINK_HW
+    esp_timer_handle_t blinkTimer = nullptr;
+    portMUX_TYPE blinkMux = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t blinkOnUs = 0;
+    uint32_t blinkOffUs = 0;
+    bool blinkLevel = false;
+    int64_t nextEdgeUs = INT64_MAX;     ///< When the armed edge is due
+
+    /**
+     * @brief Blink edge (esp_timer task): toggle the LED and arm the next edge
+     * @details Edges are scheduled on absolute times, so slices do not drift.
+     *          A callback already dispatched when ledStep() restarted the
+     *          pattern finds the next edge still in the future and does nothing.
+     */
+    void onBlinkEdge(void* arg) {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&blinkMux);
+        if (now + 1000 < nextEdgeUs) {
+            portEXIT_CRITICAL(&blinkMux);
+            return;
+        }
+        int64_t dueUs = nextEdgeUs;
+        blinkLevel = !blinkLevel;
+        digitalWrite((int)LED_GPIO, blinkLevel ? HIGH : LOW);
+        nextEdgeUs += blinkLevel ? blinkOnUs : blinkOffUs;
+        if (nextEdgeUs <= now) nextEdgeUs = now + 1;  // More than a slice late: resync
+        esp_timer_start_once(blinkTimer, (uint64_t)(nextEdgeUs - now));
+        portEXIT_CRITICAL(&blinkMux);
+
+        recordEdge(dueUs, now);
+        gLive.ledOn = blinkLevel ? 1 : 0;
+        gLive.led_last_ms = millis();
+    }
+#else
+    bool ledState = false;      ///< Current blink phase
+    bool ledCritical = false;   ///< Last step held the LED on (CRITICAL)
+    int64_t lastEdgeUs = 0;     ///< Time of the last LED write
+    uint32_t lastSliceMs = 0;   ///< Slice requested after it
+#endif
+}
+
+/**
+ * @brief LED setup (pin low, wait for the first band)
+ */
+void ledInit() {
+    pinMode((int)LED_GPIO, OUTPUT);
+    digitalWrite((int)LED_GPIO, LOW);
+    gLive.ledOn = 0;
+
+#if LED_BLINK_HW
+    esp_timer_create_args_t args = {};
+    args.callback = onBlinkEdge;
+    args.name = "led_blink";
+    if (esp_timer_create(&args, &blinkTimer) != ESP_OK) {
+        Serial.println("[TASK2] ✗ Failed to create blink timer");
+    }
+#endif
+
+    Serial.println("[TASK2] LED control task started");
+    Serial.println("[TASK2] Waiting for semBandChanged from Task 1...");
+}
+
+#if LED_BLINK_HW
+/**
+ * @brief Restart the blink timer chain with the new band's pattern
+ * @param signaled true when semBandChanged arrived
+ * @return kWaitForever (the timer drives the edges)
+ */
+uint32_t ledStep(bool signaled) {
+    if (!signaled) return kWaitForever;
+    gLive.takeTemp++;
+    if (!ledStarted) {
+        ledStarted = true;
+        DLOG_I("[TASK2] ✓ Received first semBandChanged\n");
+    } else {
+        DLOG_I("[TASK2] ✓ Received semBandChanged (new band: %s)\n", bandName(gLive.tBand));
+    }
+
+    uint32_t onMs, offMs;
+    bandToBlink(gLive.tBand, onMs, offMs);
+    gLive.onMs = onMs;
+    gLive.offMs = offMs;
+    bool critical = gLive.tBand == TempBand::CRITICAL;
+
+    // Every pattern starts with the on phase; CRITICAL stays on without a timer
+    portENTER_CRITICAL(&blinkMux);
+    esp_timer_stop(blinkTimer);  // ESP_ERR_INVALID_STATE when idle is fine
+    blinkOnUs = onMs * 1000;
+    blinkOffUs = offMs * 1000;
+    blinkLevel = true;
+    digitalWrite((int)LED_GPIO, HIGH);
+    if (critical) {
+        nextEdgeUs = INT64_MAX;
+    } else {
+        nextEdgeUs = esp_timer_get_time() + blinkOnUs;
+        esp_timer_start_once(blinkTimer, blinkOnUs);
+    }
+    portEXIT_CRITICAL(&blinkMux);
+    latencyMark(LAT_BAND_LED);
+
+    gLive.ledOn = 1;
+    gLive.led_last_ms = millis();
+    gLive.led_runs++;
+    return kWaitForever;
+}
+#else
+/**
+ * @brief One LED step
+ * @param signaled true when semBandChanged arrived, false when the
+ *        previous blink slice timed out
+ * @return Length of the next slice in ms (kWaitForever before the first band)
+ */
+uint32_t ledStep(bool signaled) {
+    bool sliceElapsed = false;
+    if (!ledStarted) {
+        // SEMAPHORE WAIT: Block until first temperature reading
+        if (!signaled) return kWaitForever;
+        ledStarted = true;
+        gLive.takeTemp++;
+        DLOG_I("[TASK2] ✓ Received first semBandChanged\n");
+    } else if (signaled) {
+        gLive.takeTemp++;
+        if (ledCritical) {
+            DLOG_I("[TASK2] ✓ Received semBandChanged (was CRITICAL)\n");
+        } else {
+            // Restart blink cycle with new pattern
+            DLOG_I("[TASK2] ✓ Received semBandChanged (new band: %s)\n", 
+                   bandName(gLive.tBand));
+        }
+    } else if (!ledCritical) {
+        ledState = !ledState;  // Slice elapsed without a band change
+        sliceElapsed = true;
+    }
+
+    uint32_t onMs, offMs;
+    bandToBlink(gLive.tBand, onMs, offMs);
+    gLive.onMs = onMs; 
+    gLive.offMs = offMs;
+
+    // CRITICAL state: LED always ON (re-check for band change every 100ms)
+    ledCritical = gLive.tBand == TempBand::CRITICAL;
+    if (ledCritical) {
+        digitalWrite((int)LED_GPIO, HIGH);
+        if (signaled) latencyMark(LAT_BAND_LED);
+        gLive.ledOn = 1;
+        gLive.led_last_ms = millis();
+        gLive.led_runs++;
+        return 100;
+    }
+
+    // Normal blinking
+    digitalWrite((int)LED_GPIO, ledState ? HIGH : LOW);
+    if (signaled) latencyMark(LAT_BAND_LED);
+    int64_t now = esp_timer_get_time();
+    if (sliceElapsed) recordEdge(lastEdgeUs + (int64_t)lastSliceMs * 1000, now);
+    gLive.ledOn = ledState ? 1 : 0;
+    gLive.led_last_ms = millis();
+    gLive.led_runs++;
+
+    uint32_t slice = ledState ? onMs : offMs;
+    if (slice == 0) slice = 1;
+    lastEdgeUs = now;
+    lastSliceMs = slice;
+    return slice;
+}
+#endif
 
 /**
  * @brief Task 2 Handler - LED Temperature Indicator
@@ -22,6 +215,8 @@
  *   * NORMAL: Medium blink (300ms/300ms)
  *   * HOT: Fast blink (120ms/120ms)
  *   * CRITICAL: Always ON (no blinking)
+ * - With LED_BLINK_HW the edges come from the blink timer and the task
+ *   only wakes on band changes
  * 
  * Semaphore Usage:
  * - WAITS on semBandChanged (given by Task 1 when temp band changes)
@@ -29,60 +224,81 @@
  * @param pv Unused parameter (FreeRTOS requirement)
  */
 void task_led(void* pv) {
-    pinMode((int)LED_GPIO, OUTPUT);
-    digitalWrite((int)LED_GPIO, LOW);
-    gLive.ledOn = 0;
+    ledInit();
+    runAsTask(ledStep, EV_BAND_CHANGED);
+}
 
-    Serial.println("[TASK2] LED control task started");
-    Serial.println("[TASK2] Waiting for semBandChanged from Task 1...");
+/* ====== Task 3: NeoPixel Humidity ====== */
 
-    // SEMAPHORE WAIT: Block until first temperature reading
-    xSemaphoreTake(semBandChanged, portMAX_DELAY);  // ← Wait for Task 1
-    gLive.takeTemp++;
-    Serial.println("[TASK2] ✓ Received first semBandChanged");
-
-    bool ledState = false;
-
-    for (;;) {
-        uint32_t onMs, offMs;
-        bandToBlink(gLive.tBand, onMs, offMs);
-        gLive.onMs = onMs; 
-        gLive.offMs = offMs;
-
-        // CRITICAL state: LED always ON
-        if (gLive.tBand == TempBand::CRITICAL) {
-            digitalWrite((int)LED_GPIO, HIGH);
-            gLive.ledOn = 1;
-            gLive.led_last_ms = millis();
-            gLive.led_runs++;
-            
-            // SEMAPHORE WAIT: Check for band change with timeout
-            if (xSemaphoreTake(semBandChanged, pdMS_TO_TICKS(100)) == pdTRUE) {
-                gLive.takeTemp++;
-                Serial.println("[TASK2] ✓ Received semBandChanged (was CRITICAL)");
-            }
-            continue;
-        }
+namespace {
+    bool humStarted = false;    ///< First semHumChanged received
+    uint32_t humGives = 0;      ///< gLive.giveHum at the last band repaint
+    std::atomic<bool> humResend{false};  ///< Stale pixel, woken by the UI task (LED_SERVICE=0)
+}
 
-        // Normal blinking
-        digitalWrite((int)LED_GPIO, ledState ? HIGH : LOW);
-        gLive.ledOn = ledState ? 1 : 0;
-        gLive.led_last_ms = millis();
-        gLive.led_runs++;
+/**
+ * @brief Humidity pixel setup
+ */
+void neoHumInit() {
+    neoPresent(NEO_STRIP_HUM);  // First frame is always sent: clear to black
 
-        uint32_t slice = ledState ? onMs : offMs;
-        if (slice == 0) slice = 1;
+    Serial.println("[TASK3] NeoPixel humidity indicator started");
+    Serial.println("[TASK3] Waiting for semHumChanged from Task 1...");
+}
 
-        // SEMAPHORE WAIT: Wait for timeout or band change
-        if (xSemaphoreTake(semBandChanged, pdMS_TO_TICKS(slice)) == pdTRUE) {
-            gLive.takeTemp++;
-            Serial.printf("[TASK2] ✓ Received semBandChanged (new band: %s)\n", 
-                          bandName(gLive.tBand));
-            continue;  // Restart blink cycle with new pattern
-        }
+/**
+ * @brief Repaint the humidity pixel after a band change
+ * @param signaled true when semHumChanged arrived
+ * @return kWaitForever (purely event-driven)
+ */
+uint32_t neoHumStep(bool signaled) {
+    // SEMAPHORE WAIT: Block until first humidity reading / next change
+    if (!signaled) return kWaitForever;
+
+    // Woken only to re-send the pixel through a new brightness level: not
+    // a band change, so no take count, log or latency mark
+    uint32_t gives = gLive.giveHum;
+    if (humResend.exchange(false) && gives == humGives) {
+        neoPresent(NEO_STRIP_HUM);
+        return kWaitForever;
+    }
+    humGives = gives;
+    gLive.takeHum++;
+    if (!humStarted) {
+        humStarted = true;
+        DLOG_I("[TASK3] ✓ Received first semHumChanged\n");
+    } else {
+        DLOG_I("[TASK3] ✓ Received semHumChanged (new band: %s)\n", 
+               humName(gLive.hBand));
+    }
 
-        ledState = !ledState;
+    // Set color based on humidity band
+    uint32_t color = 0;
+    switch (gLive.hBand) {
+        case HumBand::DRY:     
+            color = neoColor(0, 0, 255);  // Blue
+            DLOG_D("[TASK3] Setting color: BLUE (DRY)\n");
+            break;
+        case HumBand::COMFORT: 
+            color = neoColor(0, 255, 0);  // Green
+            DLOG_D("[TASK3] Setting color: GREEN (COMFORT)\n");
+            break;
+        case HumBand::HUMID:   
+            color = neoColor(255, 255, 0);  // Yellow
+            DLOG_D("[TASK3] Setting color: YELLOW (HUMID)\n");
+            break;
+        case HumBand::WET:     
+            color = neoColor(255, 0, 0);  // Red
+            DLOG_D("[TASK3] Setting color: RED (WET)\n");
+            break;
     }
+    
+    neoFrame(NEO_STRIP_HUM)[0] = color;
+    neoPresent(NEO_STRIP_HUM);
+    latencyMark(LAT_HUM_NEO);
+    gLive.neo_last_ms = millis();
+    gLive.neo_runs++;
+    return kWaitForever;
 }
 
 /**
@@ -102,51 +318,112 @@ void task_led(void* pv) {
  * @param pv Unused parameter (FreeRTOS requirement)
  */
 void task_neopixel_hum(void* pv) {
-    stripHum.begin();
-    stripHum.show();
+    neoHumInit();
+    runAsTask(neoHumStep, EV_HUM_CHANGED);
+}
 
-    Serial.println("[TASK3] NeoPixel humidity indicator started");
-    Serial.println("[TASK3] Waiting for semHumChanged from Task 1...");
+/* ====== Task 4: NeoPixel UI Bar ====== */
 
-    // SEMAPHORE WAIT: Block until first humidity reading
-    xSemaphoreTake(semHumChanged, portMAX_DELAY);  // ← Wait for Task 1
-    gLive.takeHum++;
-    Serial.println("[TASK3] ✓ Received first semHumChanged");
-
-    for (;;) {
-        // Set color based on humidity band
-        uint32_t color;
-        switch (gLive.hBand) {
-            case HumBand::DRY:     
-                color = stripHum.Color(0, 0, 255);  // Blue
-                Serial.println("[TASK3] Setting color: BLUE (DRY)");
-                break;
-            case HumBand::COMFORT: 
-                color = stripHum.Color(0, 255, 0);  // Green
-                Serial.println("[TASK3] Setting color: GREEN (COMFORT)");
-                break;
-            case HumBand::HUMID:   
-                color = stripHum.Color(255, 255, 0);  // Yellow
-                Serial.println("[TASK3] Setting color: YELLOW (HUMID)");
-                break;
-            case HumBand::WET:     
-                color = stripHum.Color(255, 0, 0);  // Red
-                Serial.println("[TASK3] Setting color: RED (WET)");
-                break;
-        }
+namespace {
+    uint16_t hue = 0;           ///< DEMO phase (8.8 fixed point)
+
+    uint8_t patternMode = 0xFF; ///< Mode the keyframe clock was started for
+    int64_t patternStartUs = 0; ///< Keyframe clock origin (esp_timer)
+
+    // Uploaded pattern (UI mode 5), refreshed when the upload generation changes
+    NeoKeyframe customKeys[NEO_PATTERN_MAX_KEYS];
+    NeoPattern customPattern = { customKeys, 0 };
+    uint32_t customGen = 0;
+
+    /**
+     * @brief Render the current keyframe of a pattern
+     * @return ms until the next keyframe (capped at NEO_PATTERN_MAX_SLEEP_MS)
+     */
+    uint32_t playPattern(uint32_t* frame, const NeoPattern& p, int64_t nowUs) {
+        NeoPatternPos pos = neoPatternAt(p, nowUs - patternStartUs);
+        neoFxFill(frame, NEOPIXEL_UI_NUM, pos.color);
+        if (pos.nextMs == 0 || pos.nextMs > NEO_PATTERN_MAX_SLEEP_MS) return NEO_PATTERN_MAX_SLEEP_MS;
+        return pos.nextMs;
+    }
+}
+
+/**
+ * @brief UI strip setup
+ */
+void neoUiInit() {
+    neoPresent(NEO_STRIP_UI);
+#if NEO_RENDER_BENCH
+    neoRenderBench();
+#endif
+
+    Serial.println("[TASK4] NeoPixel UI bar started");
+    Serial.println("[TASK4] Sleeps until the next keyframe or semUiMode (user-controlled)");
+}
+
+/**
+ * @brief Render one frame of the current UI mode
+ * @param signaled true when semUiMode arrived (mode changed)
+ * @return UI_STRIP_UPDATE_MS for BAR/DEMO, time to the next keyframe for
+ *         SOS/BLINK/uploaded patterns, NEO_PATTERN_MAX_SLEEP_MS when OFF
+ */
+uint32_t neoUiStep(bool signaled) {
+    deadlineBegin(DL_NEO_UI);
+    uint32_t* frame = neoFrame(NEO_STRIP_UI);
+    uint8_t mode = gLive.uiMode;
+    int64_t now = esp_timer_get_time();
+    uint32_t next = UI_STRIP_UPDATE_MS;
+
+    // Patterns start from their first keyframe when the mode is entered
+    if (mode != patternMode) {
+        patternMode = mode;
+        patternStartUs = now;
+    }
+
+    if (mode == 0) {
+        // Mode 0: OFF - all pixels off, sleep until the mode changes
+        neoFxFill(frame, NEOPIXEL_UI_NUM, 0);
+        next = NEO_PATTERN_MAX_SLEEP_MS;
         
-        stripHum.setPixelColor(0, color);
-        stripHum.show();
-        gLive.neo_last_ms = millis();
-        gLive.neo_runs++;
-
-        // SEMAPHORE WAIT: Block until next humidity change
-        if (xSemaphoreTake(semHumChanged, portMAX_DELAY) == pdTRUE) {
-            gLive.takeHum++;
-            Serial.printf("[TASK3] ✓ Received semHumChanged (new band: %s)\n", 
-                          humName(gLive.hBand));
+    } else if (mode == 1) {
+        // Mode 1: BAR - show humidity as bar graph
+        // 4 LEDs: 0-25%: 1 LED, 25-50%: 2 LEDs, 50-75%: 3 LEDs, 75-100%: 4 LEDs
+        float h = gLive.rh;
+        uint16_t pct10 = h > 0 ? (uint16_t)min(h * 10.0f, 1000.0f) : 0;  // NAN → 0
+        neoFxBar(frame, NEOPIXEL_UI_NUM, pct10, neoColor(0, 100, 255));
+        
+    } else if (mode == 2) {
+        // Mode 2: DEMO - rainbow animation (hue table, one load per pixel)
+        neoFxRainbow(frame, NEOPIXEL_UI_NUM, hue, NEO_DEMO_SPACING);
+        hue += NEO_DEMO_STEP;
+        
+    } else if (mode == 3) {
+        // Mode 3: SOS - S.O.S distress signal pattern
+        next = playPattern(frame, kNeoSos, now);
+        
+    } else if (mode == 4) {
+        // Mode 4: BLINK - Fast warning blink
+        next = playPattern(frame, kNeoBlink, now);
+        
+    } else if (mode == 5) {
+        // Mode 5: uploaded pattern (POST /ui/pattern)
+        if (neoPatternGeneration() != customGen) {
+            customGen = neoPatternCustom(customKeys, customPattern.count);
+            patternStartUs = now;
         }
+        next = playPattern(frame, customPattern, now);
+    }
+
+    // Transmitted only when a pixel changed (OFF and a steady BAR send nothing)
+    neoPresent(NEO_STRIP_UI);
+    // Split tasks: the humidity pixel only wakes on a band change, so a
+    // new brightness level (applied above) needs a nudge to reach it
+    if (!LED_SERVICE && neoStale(NEO_STRIP_HUM)) {
+        humResend = true;
+        wakeEvent(EV_HUM_CHANGED);
     }
+    deadlineNext(DL_NEO_UI, next);
+    deadlineEnd(DL_NEO_UI);
+    return next;
 }
 
 /**
@@ -154,126 +431,19 @@ void task_neopixel_hum(void* pv) {
  * 
  * Responsibilities:
  * - Control 4-pixel NeoPixel strip (GPIO 6) for user interface
- * - Support 3 modes (no semaphore, user-controlled from web):
+ * - Support 6 modes (user-controlled from web):
  *   * Mode 0: OFF - All pixels off
  *   * Mode 1: BAR - Show humidity as bar graph (0-100% → 0-4 LEDs)
  *   * Mode 2: DEMO - Rainbow animation
+ *   * Modes 3/4/5: SOS, BLINK, uploaded keyframe pattern (neo_pattern.h)
  * 
  * Semaphore Usage:
- * - NONE (runs independently, no synchronization needed)
+ * - WAITS on semUiMode (given by the web handlers when the mode changes),
+ *   with the frame period or the time to the next keyframe as timeout
  * 
  * @param pv Unused parameter (FreeRTOS requirement)
  */
 void task_neopixel_ui(void* pv) {
-    stripUI.begin();
-    stripUI.show();
-    uint32_t hue = 0;
-
-    Serial.println("[TASK4] NeoPixel UI bar started");
-    Serial.println("[TASK4] No semaphore - runs independently (user-controlled)");
-
-    // SOS pattern: ... --- ... (3 short, 3 long, 3 short)
-    const int sosPattern[] = {1,0,1,0,1,0,0,3,0,3,0,3,0,0,1,0,1,0,1,0,0,0}; // 1=short, 3=long, 0=off
-    const int sosPatternLen = sizeof(sosPattern) / sizeof(sosPattern[0]);
-    int sosIndex = 0;
-    int sosBeatCount = 0;
-    const int sosBeatDuration = 2; // number of loop iterations per beat
-    
-    // Blink pattern state
-    bool blinkState = false;
-    int blinkCounter = 0;
-    const int blinkInterval = 3; // blink every 3 loop iterations
-
-    for (;;) {
-        if (gLive.uiMode == 0) {
-            // Mode 0: OFF - all pixels off
-            for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                stripUI.setPixelColor(i, 0);
-            }
-            stripUI.show();
-            
-        } else if (gLive.uiMode == 1) {
-            // Mode 1: BAR - show humidity as bar graph (4 LEDs)
-            float h = gLive.rh;
-            
-            // Calculate number of LEDs to light (1-4 based on humidity percentage)
-            // 0-25%: 1 LED, 25-50%: 2 LEDs, 50-75%: 3 LEDs, 75-100%: 4 LEDs
-            int ledsOn;
-            if (h >= 75.0) {
-                ledsOn = 4;
-            } else if (h >= 50.0) {
-                ledsOn = 3;
-            } else if (h >= 25.0) {
-                ledsOn = 2;
-            } else if (h > 0) {
-                ledsOn = 1;
-            } else {
-                ledsOn = 0;
-            }
-            
-            // Light up the appropriate number of LEDs
-            for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                if (i < ledsOn) {
-                    stripUI.setPixelColor(i, stripUI.Color(0, 100, 255));
-                } else {
-                    stripUI.setPixelColor(i, 0);
-                }
-            }
-            stripUI.show();
-            
-        } else if (gLive.uiMode == 2) {
-            // Mode 2: DEMO - rainbow animation
-            for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                uint8_t r = (uint8_t)((sin((hue + i * 40) * 0.02f) + 1) * 127);
-                uint8_t g = (uint8_t)((sin((hue + i * 40) * 0.02f + 2.1f) + 1) * 127);
-                uint8_t b = (uint8_t)((sin((hue + i * 40) * 0.02f + 4.2f) + 1) * 127);
-                stripUI.setPixelColor(i, stripUI.Color(r, g, b));
-            }
-            stripUI.show();
-            hue += 12;
-            
-        } else if (gLive.uiMode == 3) {
-            // Mode 3: SOS - S.O.S distress signal pattern
-            sosBeatCount++;
-            if (sosBeatCount >= sosBeatDuration) {
-                sosBeatCount = 0;
-                sosIndex = (sosIndex + 1) % sosPatternLen;
-            }
-            
-            int state = sosPattern[sosIndex];
-            if (state > 0) {
-                // Red flashing for SOS
-                for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                    stripUI.setPixelColor(i, stripUI.Color(255, 0, 0));
-                }
-            } else {
-                for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                    stripUI.setPixelColor(i, 0);
-                }
-            }
-            stripUI.show();
-            
-        } else if (gLive.uiMode == 4) {
-            // Mode 4: BLINK - Fast warning blink
-            blinkCounter++;
-            if (blinkCounter >= blinkInterval) {
-                blinkCounter = 0;
-                blinkState = !blinkState;
-            }
-            
-            if (blinkState) {
-                // Orange/Yellow warning color
-                for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                    stripUI.setPixelColor(i, stripUI.Color(255, 100, 0));
-                }
-            } else {
-                for (int i = 0; i < NEOPIXEL_UI_NUM; i++) {
-                    stripUI.setPixelColor(i, 0);
-                }
-            }
-            stripUI.show();
-        }
-        
-        vTaskDelay(pdMS_TO_TICKS(UI_STRIP_UPDATE_MS));
-    }
+    neoUiInit();
+    runAsTask(neoUiStep, EV_UI_MODE);
 }
@@ -2,15 +2,105 @@
  * @file task3_lcd.cpp
  * @brief Task 3: LCD Display with Task 1 & Task 2 Conditions
  * 
- * This task updates the LCD display to show:
- * - Line 1: Task 1 sensor data (Temperature & Humidity)
- * - Line 2: Task 2 LED status (band state and LED on/off)
+ * This task updates the LCD display with one of the pages in
+ * lcd_pages.h (sensor values and bands, sparklines, anomaly scores,
+ * network), rotated on a timer or selected by the page button / web.
+ *
+ * Rows are rendered into the LCD shadow (lcd_shadow.h); only characters
+ * and glyphs that changed are sent over I2C.
  */
 
 #include <Arduino.h>
 #include "../config/config.h"
 #include "../config/system_types.h"
 #include "../hardware/hardware_manager.h"
+#include "../hardware/lcd_shadow.h"
+#include "../hardware/lcd_bus.h"
+#include "executor.h"
+#include "lcd_pages.h"
+#include "latency_bench.h"
+#include "power_manager.h"
+#include "deferred_log.h"
+#include "trace_recorder.h"
+
+namespace {
+    constexpr uint32_t kSplashMs = 2000;   ///< Startup message duration
+    uint32_t splashStart = 0;
+    bool splashing = false;
+    bool updatePending = false;            ///< semLcdUpdate arrived during the splash
+    uint32_t sampledRuns = 0;              ///< gLive.dht_runs of the last sparkline sample
+}
+
+/**
+ * @brief LCD setup and startup message
+ */
+void lcdInit() {
+    lcd.init();
+    lcd.backlight();
+#if LCD_BENCH
+    lcdBench();
+#endif
+    lcd.clear();                   // Last clear(): from here on the shadow diffs
+    lcdShadowInit();
+    lcdShadowPrintf(0, "ESP32-S3 LAB");
+    lcdShadowPrintf(1, "Task 1 & 2 Info");
+    lcdShadowFlush();
+    lcdPagesInit();
+
+    Serial.printf("[TASK3] LCD display task started (%s bus)\n", lcdBusName());
+    Serial.println("[TASK3] Showing Task 1 (Sensor) & Task 2 (LED) conditions");
+    Serial.println("[TASK3] Waiting for semLcdUpdate from Task 1...");
+
+    splashStart = millis();
+    splashing = true;
+}
+
+/**
+ * @brief Redraw the current page after semLcdUpdate or a page change
+ * @param signaled true when semLcdUpdate arrived (reading, button or web)
+ * @return Remaining splash time, then time to the next page rotation
+ *         (kWaitForever with LCD_PAGE_ROTATE_MS=0)
+ */
+uint32_t lcdStep(bool signaled) {
+    updatePending |= signaled;
+
+    // Every new reading feeds the sparklines, whichever page is shown
+    if (gLive.dht_runs != sampledRuns) {
+        sampledRuns = gLive.dht_runs;
+        lcdPagesSample(gLive.tC, gLive.rh);
+    }
+
+    // Show startup message for 2 seconds
+    uint32_t now = millis();
+    uint32_t shown = now - splashStart;
+    if (splashing && shown < kSplashMs) return kSplashMs - shown;
+    splashing = false;
+
+    bool pageChanged = lcdPageAdvance(now);
+    if (!updatePending && !pageChanged) return lcdPageRotateIn(now);
+    updatePending = false;
+    uint8_t page = lcdPageCurrent();
+
+    static const uint8_t kTraceLcd = traceLabel("LCD");
+    traceRecord(TRACE_I2C_BEGIN, kTraceLcd);
+    pmAcquire(PM_LOCK_I2C);
+
+    // Changed characters and glyphs only: no clear(), no flicker
+    lcdPageRender(page);
+    uint32_t i2cBytes = lcdShadowFlush();
+
+    pmRelease(PM_LOCK_I2C);
+    traceRecord(TRACE_I2C_END, kTraceLcd);
+    latencyMark(LAT_LCD_REPAINT);
+    latencyMark(LAT_SAMPLE_LCD);
+
+    gLive.lcd_last_ms = millis();
+    gLive.lcd_runs++;
+
+    DLOG_D("[TASK3] ✓ LCD updated - Page %s | T=%.1f°C H=%.1f%% | I2C %u B\n",
+           lcdPageName(page), gLive.tC, gLive.rh, (unsigned)i2cBytes);
+    return lcdPageRotateIn(millis());
+}
 
 /**
  * @brief Task 3 Handler - LCD Display (Combined Task 1 & Task 2 Info)
@@ -19,9 +109,9 @@
  * - Wait for semLcdUpdate semaphore from Task 1
  * - Display Task 1 data: Temperature and Humidity readings
  * - Display Task 2 status: Temperature band and LED state
- * - Display format:
- *   Line 1: "T:25.5C  H:55.0%"
- *   Line 2: "HOT LED:ON"
+ * - Display format (SENSOR page, see lcd_pages.h for the others):
+ *   Line 1: "T:25.5C H:55%"
+ *   Line 2: "T:NORM H:OK"
  * 
  * Semaphore Usage:
  * - WAITS on semLcdUpdate (given by Task 1 every time sensor is read)
@@ -29,78 +119,6 @@
  * @param pv Unused parameter (FreeRTOS requirement)
  */
 void task_lcd(void* pv) {
-    lcd.init();
-    lcd.backlight();
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print("ESP32-S3 LAB");
-    lcd.setCursor(0, 1);
-    lcd.print("Task 1 & 2 Info");
-
-    Serial.println("[TASK3] LCD display task started");
-    Serial.println("[TASK3] Showing Task 1 (Sensor) & Task 2 (LED) conditions");
-    Serial.println("[TASK3] Waiting for semLcdUpdate from Task 1...");
-
-    vTaskDelay(pdMS_TO_TICKS(2000)); // Show startup message for 2 seconds
-
-    for (;;) {
-        // SEMAPHORE WAIT: Block until Task 1 signals update
-        if (xSemaphoreTake(semLcdUpdate, portMAX_DELAY) == pdTRUE) {
-            float t = gLive.tC;
-            float h = gLive.rh;
-            TempBand tb = gLive.tBand;
-            HumBand hb = gLive.hBand;
-
-            // Line 1: Task 1 - Actual Temperature and Humidity values
-            lcd.clear();
-            lcd.setCursor(0, 0);
-            lcd.print("T:");
-            lcd.print(t, 1);
-            lcd.print("C ");
-            lcd.print("H:");
-            lcd.print(h, 0);
-            lcd.print("%");
-
-            // Line 2: Task 2 - Status/Condition of both Temperature and Humidity
-            lcd.setCursor(0, 1);
-            
-            // Show temperature status (abbreviated)
-            switch (tb) {
-                case TempBand::COLD:
-                    lcd.print("T:COLD ");
-                    break;
-                case TempBand::NORMAL:
-                    lcd.print("T:NORM ");
-                    break;
-                case TempBand::HOT:
-                    lcd.print("T:HOT ");
-                    break;
-                case TempBand::CRITICAL:
-                    lcd.print("T:CRIT ");
-                    break;
-            }
-
-            // Show humidity status (abbreviated)
-            switch (hb) {
-                case HumBand::DRY:
-                    lcd.print("H:DRY");
-                    break;
-                case HumBand::COMFORT:
-                    lcd.print("H:OK");
-                    break;
-                case HumBand::HUMID:
-                    lcd.print("H:HUM");
-                    break;
-                case HumBand::WET:
-                    lcd.print("H:WET");
-                    break;
-            }
-
-            gLive.lcd_last_ms = millis();
-            gLive.lcd_runs++;
-            
-            Serial.printf("[TASK3] ✓ LCD updated - Values: T=%.1f°C H=%.1f%% | Status: T=%s H=%s\n", 
-                          t, h, bandName(tb), humName(hb));
-        }
-    }
+    lcdInit();
+    runAsTask(lcdStep, EV_LCD_UPDATE);
 }
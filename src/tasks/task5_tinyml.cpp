@@ -12,7 +12,7 @@
  * - Real-time inference every 5 seconds
  * - Uses sensor data from Task 1 (DHT20)
  * - Outputs anomaly score (0.0 = normal, 1.0 = anomalous)
- * - Minimal memory footprint (8KB tensor arena)
+ * - Minimal memory footprint (one 8KB tensor arena shared by all models)
  * - Independent task (no semaphore synchronization)
  * 
  * Model Details:
@@ -20,26 +20,36 @@
  * - Output: 1 float (anomaly score)
  * - Model file: dht_anomaly_model.h (trained neural network)
  * - Framework: TensorFlow Lite Micro for embedded systems
+ * - Runs as entry 0 of the model pipeline (model_pipeline.h), followed
+ *   by any optional models on the same snapshot
  * 
  * Performance:
  * - Inference time: ~200-500ms per run
- * - Memory: 8KB tensor arena + model size
+ * - Memory: TINYML_ARENA_SIZE shared arena + model size
  * - Power: Minimal impact (runs at low priority)
  */
 
 #include <Arduino.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 #include "../config/config.h"
 #include "../config/system_types.h"
 #include "../ml/tinyml.h"
+#include "../ml/dht_anomaly_kernel.h"
+#include "../ml/model_store.h"
+#include "../ml/model_pipeline.h"
+#include "../ml/tinyml_bench.h"
+#include "deadline_monitor.h"
+#include "deferred_log.h"
 
 /* ====== TensorFlow Lite Micro Components ====== */
 
 /**
  * @brief Anonymous namespace for TinyML global objects
- * @details These objects maintain TensorFlow Lite Micro state across
- *          inference calls. They are initialized once and reused.
+ * @details The interpreter and tensor arena live in the model pipeline
+ *          (model_pipeline.cpp) and are shared with the other models;
+ *          this task only owns the anomaly model images.
  * @note Using anonymous namespace prevents name collisions
  */
 namespace
@@ -49,58 +59,92 @@ namespace
      * @details Logs errors to serial console during inference
      */
     tflite::ErrorReporter *error_reporter = nullptr;
-    
-    /**
-     * @brief Loaded neural network model
-     * @details Parsed from dht_anomaly_model_tflite array
-     */
-    const tflite::Model *model = nullptr;
-    
-    /**
-     * @brief TensorFlow Lite Micro interpreter
-     * @details Executes the neural network forward pass
-     */
-    tflite::MicroInterpreter *interpreter = nullptr;
-    
-    /**
-     * @brief Input tensor (temperature, humidity)
-     * @details 2-element float array: [temperature, humidity]
-     */
-    TfLiteTensor *input = nullptr;
-    
-    /**
-     * @brief Output tensor (anomaly score)
-     * @details Single float: 0.0 (normal) to 1.0 (anomalous)
-     */
-    TfLiteTensor *output = nullptr;
-    
+
     /**
-     * @brief Tensor arena size in bytes
-     * @details Working memory for intermediate activations and weights
-     *          8KB is sufficient for small models (<10 layers)
-     * @note Increase if model is complex or has many parameters
+     * @brief Double-buffered RAM copies of stored models
+     * @details A new upload is loaded into the standby image and validated
+     *          while the pipeline still points at the active one, so a bad
+     *          upload never interrupts inference.
      */
-    constexpr int kTensorArenaSize = 8 * 1024;  // 8 KB
-    
+    alignas(16) uint8_t modelImages[2][TINYML_MODEL_MAX_BYTES];
+
     /**
-     * @brief Tensor arena memory buffer
-     * @details Static allocation ensures memory is not on stack
-     *          This buffer holds all intermediate tensors during inference
+     * @brief Image the anomaly model currently runs from (-1 = compiled-in)
      */
-    uint8_t tensor_arena[kTensorArenaSize];
+    int activeImage = -1;
 } // namespace
 
+/* ====== Model Images ====== */
+
+/**
+ * @brief Install an anomaly model in the pipeline
+ * @param image modelImages index holding the flatbuffer, -1 = compiled-in model
+ * @param len Flatbuffer size in bytes
+ * @param[out] reason Short rejection reason on failure
+ * @return true if the pipeline now runs this model
+ * @details pipelineSetModel() checks flatbuffer structure, schema version,
+ *          operator availability, arena fit, the 2-in/1-out signature and
+ *          that a probe inference returns a score in 0.0-1.0.
+ */
+static bool installAnomalyModel(int image, size_t len, const char *&reason)
+{
+    const uint8_t *data = image < 0 ? dht_anomaly_model_tflite : modelImages[image];
+    if (!pipelineSetModel(PIPE_ANOMALY, data, len, image < 0, reason)) return false;
+
+    activeImage = image;
+    gModelStore.stored = image >= 0;
+    gModelStore.activeBytes = len;
+    return true;
+}
+
+/**
+ * @brief Validate a staged upload in the standby image and swap it in
+ * @details The active image is untouched until the new model passes every
+ *          check, so a bad upload never interrupts inference.
+ */
+static void swapStagedModel()
+{
+    int standby = activeImage == 0 ? 1 : 0;
+    const char *reason = "read failed";
+    uint32_t gen = 0;
+    size_t n = modelLoadStaged(modelImages[standby], sizeof(modelImages[standby]), gen);
+
+    if (n > 0 && installAnomalyModel(standby, n, reason))
+    {
+        if (modelResolveStaged(gen, true))
+            Serial.printf("[TinyML] ✓ Swapped to uploaded model (%u bytes)\n", (unsigned)n);
+        else
+            Serial.println("[TinyML] Uploaded model replaced during validation - validating the newer one next");
+    }
+    else
+    {
+        if (modelResolveStaged(gen, false, reason))
+            Serial.printf("[TinyML] ✗ Uploaded model rejected (%s) - keeping current model\n", reason);
+    }
+}
+
+/**
+ * @brief Swap back to the compiled-in model
+ */
+static void swapBuiltinModel()
+{
+    const char *reason = "";
+    if (installAnomalyModel(-1, sizeof(dht_anomaly_model_tflite), reason))
+    {
+        Serial.println("[TinyML] ✓ Reverted to compiled-in model");
+    }
+}
+
 /* ====== TinyML Initialization ====== */
 
 /**
- * @brief Initialize TensorFlow Lite Micro interpreter
+ * @brief Initialize TensorFlow Lite Micro and the model pipeline
  * @details Performs one-time setup:
  *          1. Create error reporter for debugging
- *          2. Load and validate neural network model
- *          3. Create operation resolver (registers ops like Dense, ReLU)
- *          4. Create interpreter with tensor arena
- *          5. Allocate tensors (input, output, intermediate)
- *          6. Get pointers to input/output tensors
+ *          2. Register the optional pipeline models (comfort, forecast)
+ *          3. Load the anomaly model persisted on LittleFS (if any)
+ *          4. Fall back to the compiled-in model if none or invalid
+ *          5. Report the shared arena plan
  * 
  * @note This function is called once when TinyML task starts
  * @warning Failure here will cause task to self-destruct
@@ -114,48 +158,138 @@ void setupTinyML()
     static tflite::MicroErrorReporter micro_error_reporter;
     error_reporter = &micro_error_reporter;
 
-    // Step 2: Load neural network model from flash memory
-    // Model is compiled into dht_anomaly_model.h as byte array
-    model = tflite::GetModel(dht_anomaly_model_tflite);
-    
-    // Step 3: Verify model schema version
-    // TFLITE_SCHEMA_VERSION = 3 (current version)
-    // Mismatch indicates incompatible model format
-    if (model->version() != TFLITE_SCHEMA_VERSION)
+    // Step 2: Models that share the arena with the anomaly model
+    pipelineInit();
+
+    // Step 3: Prefer the last model accepted over HTTP
+    const char *reason = "";
+    bool ready = false;
+    size_t n = modelLoadPersisted(modelImages[0], sizeof(modelImages[0]));
+    if (n > 0)
     {
-        error_reporter->Report("Model provided is schema version %d, not equal to supported version %d.",
-                               model->version(), TFLITE_SCHEMA_VERSION);
-        return;  // Fatal error - model incompatible
+        ready = installAnomalyModel(0, n, reason);
+        if (ready) Serial.printf("[TinyML] Stored model loaded (%u bytes)\n", (unsigned)n);
+        else       Serial.printf("[TinyML] Stored model invalid (%s), using compiled-in model\n", reason);
     }
 
-    // Step 4: Create operation resolver
-    // AllOpsResolver includes all TensorFlow Lite operations
-    // For production, use MicroMutableOpResolver with only needed ops (saves memory)
-    static tflite::AllOpsResolver resolver;
-    
-    // Step 5: Create interpreter
-    // Interpreter executes the model using the provided tensor arena
-    static tflite::MicroInterpreter static_interpreter(
-        model, resolver, tensor_arena, kTensorArenaSize, error_reporter);
-    interpreter = &static_interpreter;
-
-    // Step 6: Allocate tensors (input, output, intermediate activations)
-    // This reserves memory in tensor_arena for all layers
-    TfLiteStatus allocate_status = interpreter->AllocateTensors();
-    if (allocate_status != kTfLiteOk)
+    // Step 4: Compiled-in model from dht_anomaly_model.h
+    if (!ready && !installAnomalyModel(-1, sizeof(dht_anomaly_model_tflite), reason))
+    {
+        error_reporter->Report("Compiled-in model rejected: %s", reason);
+        return;  // Fatal error - anomaly entry stays not ready
+    }
+
+    // Step 5: One arena sized for the largest model instead of one per model
+    uint32_t separate = 0;
+    int models = 0;
+    for (int i = 0; i < PIPE_COUNT; i++)
+    {
+        if (!gPipeline[i].ready) continue;
+        separate += gPipeline[i].arenaBytes;
+        models++;
+    }
+    Serial.printf("[TinyML] TensorFlow Lite Micro ready (%d model%s, arena %u/%u bytes, %u if separate)\n",
+                  models, models == 1 ? "" : "s", (unsigned)gPipelinePlannedBytes,
+                  (unsigned)kPipelineArenaSize, (unsigned)separate);
+}
+
+/* ====== Kernel Verification ====== */
+
+#if TINYML_KERNEL_BENCH
+/**
+ * @brief Generate the next verification input (fixed LCG, -20..60°C, 0..100%)
+ */
+static void nextBenchInput(uint32_t &seed, float &t, float &h)
+{
+    seed = seed * 1664525u + 1013904223u;
+    t = -20.0f + 80.0f * ((seed >> 8) & 0xFFFF) / 65535.0f;
+    seed = seed * 1664525u + 1013904223u;
+    h = 100.0f * ((seed >> 8) & 0xFFFF) / 65535.0f;
+}
+
+/**
+ * @brief Check the hand-specialized kernel against the TFLM interpreter
+ * @details Three passes over the same TINYML_KERNEL_BENCH_SAMPLES inputs:
+ *          1. Interpreter only (timed)
+ *          2. Kernel only (timed)
+ *          3. Both, comparing scores against TINYML_KERNEL_TOLERANCE
+ *          Timing whole passes keeps the 1µs timer resolution out of the result.
+ */
+static void benchAnomalyKernel()
+{
+    const int n = TINYML_KERNEL_BENCH_SAMPLES;
+    const uint32_t kSeed = 0x12345678;
+    uint32_t seed;
+    float t, h;
+    volatile float sink = 0.0f;  // Keeps the timed loops from being optimized away
+
+    if (!gPipeline[PIPE_ANOMALY].builtin)
+    {
+        Serial.println("[TinyML] Kernel check skipped (stored model active, kernel matches compiled-in model only)");
+        return;
+    }
+
+    const char *reason = "";
+    tflite::MicroInterpreter *interpreter = pipelineBind(gPipeline[PIPE_ANOMALY], reason);
+    if (interpreter == nullptr)
+    {
+        Serial.printf("[TinyML] Kernel check skipped (%s)\n", reason);
+        return;
+    }
+    TfLiteTensor *input = interpreter->input(0);
+    TfLiteTensor *output = interpreter->output(0);
+
+    Serial.printf("[TinyML] Verifying kernel against interpreter (%d inputs)\n", n);
+
+    // Pass 1: interpreter throughput
+    seed = kSeed;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < n; i++)
+    {
+        nextBenchInput(seed, t, h);
+        input->data.f[0] = t;
+        input->data.f[1] = h;
+        interpreter->Invoke();
+        sink += output->data.f[0];
+    }
+    int64_t tflmUs = esp_timer_get_time() - t0;
+
+    // Pass 2: kernel throughput
+    seed = kSeed;
+    t0 = esp_timer_get_time();
+    for (int i = 0; i < n; i++)
+    {
+        nextBenchInput(seed, t, h);
+        sink += dht_anomaly_kernel::anomalyScore(t, h);
+    }
+    int64_t kernelUs = esp_timer_get_time() - t0;
+
+    // Pass 3: golden-model comparison
+    seed = kSeed;
+    float maxErr = 0.0f;
+    int mismatches = 0;
+    for (int i = 0; i < n; i++)
     {
-        error_reporter->Report("AllocateTensors() failed");
-        return;  // Fatal error - not enough memory
+        nextBenchInput(seed, t, h);
+        input->data.f[0] = t;
+        input->data.f[1] = h;
+        interpreter->Invoke();
+        float err = fabsf(dht_anomaly_kernel::anomalyScore(t, h) - output->data.f[0]);
+        if (err > maxErr) maxErr = err;
+        if (err > TINYML_KERNEL_TOLERANCE) mismatches++;
     }
+    pipelineUnbind();
 
-    // Step 7: Get pointers to input and output tensors
-    // Input: 2 floats [temperature, humidity]
-    // Output: 1 float [anomaly_score]
-    input = interpreter->input(0);    // First (and only) input tensor
-    output = interpreter->output(0);  // First (and only) output tensor
+    float tflmIps   = tflmUs   > 0 ? n * 1e6f / tflmUs   : 0.0f;
+    float kernelIps = kernelUs > 0 ? n * 1e6f / kernelUs : 0.0f;
 
-    Serial.println("[TinyML] TensorFlow Lite Micro ready");
+    Serial.printf("[TinyML] Kernel max error %.2e, %d/%d over tolerance → %s\n",
+                  maxErr, mismatches, n, mismatches == 0 ? "PASS" : "FAIL");
+    Serial.printf("[TinyML] Interpreter: %.0f inv/s | Kernel (%s): %.0f inv/s | Speedup x%.1f\n",
+                  tflmIps, DHT_KERNEL_USE_DSP ? "ESP-DSP" : "scalar", kernelIps,
+                  tflmIps > 0 ? kernelIps / tflmIps : 0.0f);
 }
+#endif
 
 /* ====== TinyML Task Function ====== */
 
@@ -164,10 +298,12 @@ void setupTinyML()
  * @param pvParameters Unused (required by FreeRTOS)
  * @details Task behavior:
  *          1. Initialize TensorFlow Lite Micro (one-time setup)
+ *             (and verify the fast kernel when TINYML_KERNEL_BENCH is set,
+ *              run the trace benchmark when TINYML_BENCH is set)
  *          2. Loop forever:
  *             a. Wait for valid sensor data from Task 1
- *             b. Copy data into input tensor
- *             c. Run neural network inference
+ *             b. Run the model pipeline on [temperature, humidity]
+ *             c. Take the anomaly score from the pipeline
  *             d. Store output in global state
  *             e. Wait 5 seconds before next inference
  * 
@@ -181,17 +317,51 @@ void tiny_ml_task(void *pvParameters)
     setupTinyML();
 
     // Verify initialization succeeded
-    // If input/output tensors are null, setup failed
-    if (input == nullptr || output == nullptr)
+    // If the anomaly model is not ready, setup failed
+    if (!gPipeline[PIPE_ANOMALY].ready)
     {
         Serial.println("[TinyML] Initialization failed, deleting task");
+        Serial.println("[TinyML] Statistical detector remains the anomaly source");
         vTaskDelete(nullptr);  // Self-destruct (remove task from scheduler)
         return;
     }
 
+    gLive.tinyml_ready = 1;
+
+#if TINYML_KERNEL_BENCH
+    benchAnomalyKernel();
+#endif
+
+#if TINYML_BENCH
+    {
+        TinyMLBenchResult bench;
+        bool pass = runTinyMLBench("/trace.csv", bench);
+        if (pass)
+        {
+            pass = tinymlBenchGate("interpreter", bench.ips, TINYML_BENCH_BASELINE_IPS);
+            if (bench.kernelIps > 0.0f)
+                pass = tinymlBenchGate("kernel", bench.kernelIps, TINYML_BENCH_BASELINE_KERNEL_IPS) && pass;
+        }
+        Serial.printf("[BENCH] RESULT: %s\n", pass ? "PASS" : "FAIL");
+        if (!pass)
+        {
+            // A failed gate must not look like a healthy run: stop inference
+            Serial.println("[TinyML] Benchmark failed, deleting task");
+            gLive.tinyml_ready = 0;
+            vTaskDelete(nullptr);
+            return;
+        }
+    }
+#endif
+
     // Main inference loop
     while (1)
     {
+        // Inference boundary: apply pending model changes before the next run
+        // (the active image is never modified while it is serving)
+        if (modelRevertPending()) swapBuiltinModel();
+        if (modelStagedPending()) swapStagedModel();
+
         // Step 1: Get latest sensor readings from global state
         // These are updated by Task 1 (DHT20 sensor) every 500ms
         float temperature = gLive.tC;
@@ -204,34 +374,33 @@ void tiny_ml_task(void *pvParameters)
             vTaskDelay(pdMS_TO_TICKS(TINYML_WAIT_FOR_DATA_MS));
             continue;
         }
+        deadlineBegin(DL_TINYML);
 
-        // Step 3: Copy sensor data into input tensor
-        // Input tensor expects 2 floats: [temperature, humidity]
-        input->data.f[0] = temperature;  // First input: temperature (°C)
-        input->data.f[1] = humidity;     // Second input: humidity (%)
-
-        // Step 4: Run neural network inference
-        // This executes the forward pass through all layers
-        TfLiteStatus invoke_status = interpreter->Invoke();
-        if (invoke_status != kTfLiteOk)
+        // Steps 3-5: Run every pipeline model on the same snapshot
+        // The anomaly model uses the constexpr-weight kernel when it is the
+        // compiled-in model (TINYML_FAST_KERNEL), otherwise the interpreter
+        // bound to the shared arena
+        PipelineModel &anomaly = gPipeline[PIPE_ANOMALY];
+        const float snapshot[2] = {temperature, humidity};
+        uint32_t runsBefore = anomaly.runs;
+        pipelineRun(snapshot, 2);
+        if (anomaly.runs == runsBefore)
         {
             // Inference failed (rare - usually memory corruption)
             error_reporter->Report("Invoke failed");
             vTaskDelay(pdMS_TO_TICKS(TINYML_RETRY_DELAY_MS));
             continue;
         }
+        float result = anomaly.out[0];
 
-        // Step 5: Extract output (anomaly score)
-        // Output tensor contains single float: 0.0 (normal) to 1.0 (anomalous)
-        float result = output->data.f[0];
-        
         // Log result to serial console
-        Serial.printf("[TinyML] Score %.3f (T=%.1f°C H=%.1f%%)\n", result, temperature, humidity);
+        DLOG_I("[TinyML] Score %.3f (T=%.1f°C H=%.1f%%)\n", result, temperature, humidity);
 
         // Step 6: Store result in global state (for web API)
         gLive.tinyml_score = result;           // Anomaly score
         gLive.tinyml_last_ms = millis();       // Timestamp
         gLive.tinyml_runs++;                   // Execution counter
+        deadlineEnd(DL_TINYML);
 
         // Step 7: Wait 5 seconds before next inference
         // Inference is computationally expensive (~200-500ms)
@@ -239,41 +408,3 @@ void tiny_ml_task(void *pvParameters)
         vTaskDelay(pdMS_TO_TICKS(TINYML_INFERENCE_MS));
     }
 }
-
-/* ====== Task Creation ====== */
-
-/**
- * @brief Create TinyML FreeRTOS task
- * @details Creates a task with:
- *          - Name: "TinyML"
- *          - Stack: 8KB (large for ML operations)
- *          - Priority: 1 (low - ML is not time-critical)
- *          - Core: tskNO_AFFINITY (auto-balance)
- * 
- * @note Called by createAllTasks() in tasks.cpp
- * @note Task starts running immediately after creation
- */
-void createTinyMLTask()
-{
-    // Create TinyML task with large stack (8KB)
-    // ML operations require significant stack space
-    BaseType_t created = xTaskCreatePinnedToCore(
-        tiny_ml_task,           // Task function
-        "TinyML",               // Task name (for debugging)
-        TASK_TINYML_STACK_SIZE, // Stack size: 8192 bytes
-        nullptr,                // Task parameter (unused)
-        TASK_TINYML_PRIORITY,   // Priority: 1 (low)
-        nullptr,                // Task handle (not needed)
-        APP_CPU_NUM             // CPU core: tskNO_AFFINITY (auto-balance)
-    );
-    
-    // Verify task creation succeeded
-    if (created != pdPASS)
-    {
-        Serial.println("[TinyML] Failed to create TinyML task");
-    }
-    else
-    {
-        Serial.println("[TinyML] Task created");
-    }
-}
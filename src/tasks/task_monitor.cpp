@@ -0,0 +1,268 @@
+/**
+ * @file task_monitor.cpp
+ * @brief Task Monitor - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Window bookkeeping: every sample stores each task's cumulative run-time
+ * counter in a 10-slot ring (1 s resolution) and, every 10th sample, in a
+ * 6-slot ring (10 s resolution). A window is the difference between the
+ * current counter and the oldest slot, divided by the same difference of
+ * the total run-time counter. Unsigned subtraction keeps this correct
+ * across 32-bit counter wrap.
+ */
+
+#include "task_monitor.h"
+#include "tasks.h"
+#include "../config/config.h"
+#include "freertos/semphr.h"
+#include "esp_freertos_hooks.h"
+
+#define MON_SYSTEM_STATE  (configUSE_TRACE_FACILITY == 1)
+#define MON_RUN_TIME      (configGENERATE_RUN_TIME_STATS == 1 && MON_SYSTEM_STATE)
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr int kShortSlots = 10;   ///< 1 s samples → 1 s and 10 s windows
+    constexpr int kLongSlots  = 6;    ///< 10 s samples → ~60 s window
+
+    /**
+     * @brief Window history for one tracked task
+     */
+    struct Track {
+        TaskHandle_t handle;          ///< nullptr = free slot
+        uint32_t run1[kShortSlots];   ///< Run-time counter, last 10 samples
+        uint32_t run10[kLongSlots];   ///< Run-time counter, every 10th sample
+        uint32_t sw1[kShortSlots];    ///< Switch-ins, last 10 samples
+        bool seen;                    ///< Present in the current sample
+    };
+
+    Track tracks[TASK_MON_MAX_TASKS];
+    volatile uint32_t switchIns[TASK_MON_MAX_TASKS];   ///< Incremented by the tick hook
+    TaskHandle_t lastOnCpu[portNUM_PROCESSORS];        ///< Tick hook: task seen at the previous tick
+
+    uint32_t total1[kShortSlots];     ///< Total run-time counter, last 10 samples
+    uint32_t total10[kLongSlots];     ///< Total run-time counter, every 10th sample
+    uint32_t samples = 0;             ///< Samples taken
+
+    TaskStat stats[TASK_MON_MAX_TASKS];   ///< Latest sample (guarded by statsMutex)
+    int statCount = 0;
+    SemaphoreHandle_t statsMutex = nullptr;
+    portMUX_TYPE monMux = portMUX_INITIALIZER_UNLOCKED;   ///< tracks[].handle vs tick hook
+
+#if MON_SYSTEM_STATE
+    TaskStatus_t status[TASK_MON_MAX_TASKS];
+#endif
+} // namespace
+
+/* ====== Tick Hook ====== */
+
+/**
+ * @brief Count a switch-in when the task on this core changed since the last tick
+ * @note Tick resolution: tasks that run and block within one tick are missed,
+ *       so the rate is a lower bound
+ */
+static void IRAM_ATTR onTick() {
+    int core = xPortGetCoreID();
+    TaskHandle_t cur = xTaskGetCurrentTaskHandle();
+    if (cur == lastOnCpu[core]) return;
+    lastOnCpu[core] = cur;
+
+    portENTER_CRITICAL_ISR(&monMux);
+    for (int i = 0; i < TASK_MON_MAX_TASKS; i++) {
+        if (tracks[i].handle == cur) {
+            switchIns[i]++;
+            break;
+        }
+    }
+    portEXIT_CRITICAL_ISR(&monMux);
+}
+
+/* ====== Helper Functions ====== */
+
+/**
+ * @brief Find the track for a task, claiming a free slot for a new one
+ * @return Slot index, -1 if the table is full
+ */
+static int trackFor(TaskHandle_t h, uint32_t runNow) {
+    int free = -1;
+    for (int i = 0; i < TASK_MON_MAX_TASKS; i++) {
+        if (tracks[i].handle == h) return i;
+        if (tracks[i].handle == nullptr && free < 0) free = i;
+    }
+    if (free < 0) return -1;
+
+    Track &t = tracks[free];
+    for (int k = 0; k < kShortSlots; k++) t.run1[k] = runNow;
+    for (int k = 0; k < kLongSlots; k++) t.run10[k] = runNow;
+    for (int k = 0; k < kShortSlots; k++) t.sw1[k] = 0;
+    portENTER_CRITICAL(&monMux);
+    switchIns[free] = 0;
+    t.handle = h;
+    portEXIT_CRITICAL(&monMux);
+    return free;
+}
+
+/**
+ * @brief Percentage of one core, NAN when the window is empty
+ */
+static float share(uint32_t dRun, uint32_t dTotal) {
+    return dTotal > 0 ? 100.0f * dRun / dTotal : NAN;
+}
+
+static char stateChar(eTaskState s) {
+    switch (s) {
+        case eRunning:   return 'R';
+        case eReady:     return 'r';
+        case eBlocked:   return 'B';
+        case eSuspended: return 'S';
+        default:         return 'D';
+    }
+}
+
+/**
+ * @brief Take one sample and rebuild stats[]
+ */
+static void sampleTasks() {
+    static TaskStat fresh[TASK_MON_MAX_TASKS];   // Static: keeps ~1 KB off the MON stack
+    int n = 0;
+
+#if MON_SYSTEM_STATE
+    uint32_t totalNow = 0;
+    UBaseType_t count = uxTaskGetSystemState(status, TASK_MON_MAX_TASKS, &totalNow);
+    if (count == 0) return;  // More tasks than TASK_MON_MAX_TASKS
+
+    // Window bases (read before this sample overwrites the slots)
+    int s = samples % kShortSlots;
+    int prev = (samples + kShortSlots - 1) % kShortSlots;
+    int l = (samples / kShortSlots) % kLongSlots;
+    uint32_t dTotal1  = totalNow - total1[prev];
+    uint32_t dTotal10 = totalNow - total1[s];
+    uint32_t dTotal60 = totalNow - total10[l];
+    uint32_t window10Ms = (samples < kShortSlots ? samples : kShortSlots) * TASK_MON_SAMPLE_MS;
+
+    for (int i = 0; i < TASK_MON_MAX_TASKS; i++) tracks[i].seen = false;
+
+    for (UBaseType_t i = 0; i < count && n < TASK_MON_MAX_TASKS; i++) {
+        const TaskStatus_t &ts = status[i];
+#if MON_RUN_TIME
+        uint32_t runNow = ts.ulRunTimeCounter;
+#else
+        uint32_t runNow = 0;
+#endif
+        int slot = trackFor(ts.xHandle, runNow);
+        if (slot < 0) continue;
+        Track &t = tracks[slot];
+        t.seen = true;
+
+        TaskStat &o = fresh[n++];
+        strncpy(o.name, ts.pcTaskName, sizeof(o.name) - 1);
+        o.name[sizeof(o.name) - 1] = '\0';
+#if configTASKLIST_INCLUDE_COREID
+        o.core = ts.xCoreID == tskNO_AFFINITY ? -1 : (int8_t)ts.xCoreID;
+#else
+        o.core = -1;
+#endif
+        o.priority = (uint8_t)ts.uxCurrentPriority;
+        o.state = stateChar(ts.eCurrentState);
+        o.stackSize = taskStackSize(ts.xHandle);
+        o.stackFree = ts.usStackHighWaterMark;   // Bytes on ESP-IDF
+
+#if MON_RUN_TIME
+        uint32_t dRun10 = runNow - t.run1[s];
+        o.cpu1s  = share(runNow - t.run1[prev], dTotal1);
+        o.cpu10s = share(dRun10, dTotal10);
+        o.cpu60s = share(runNow - t.run10[l], dTotal60);
+        o.blockedMs10s = dTotal10 > 0 && dTotal10 >= dRun10
+                             ? (uint32_t)((uint64_t)(dTotal10 - dRun10) * window10Ms / dTotal10)
+                             : 0;
+#else
+        o.cpu1s = o.cpu10s = o.cpu60s = NAN;
+        o.blockedMs10s = 0;
+#endif
+        uint32_t swNow = switchIns[slot];
+        o.switchesPerSec = window10Ms > 0 ? (swNow - t.sw1[s]) * 1000.0f / window10Ms : 0.0f;
+
+        t.run1[s] = runNow;
+        t.sw1[s] = swNow;
+        if (samples % kShortSlots == 0) t.run10[l] = runNow;
+    }
+
+    total1[s] = totalNow;
+    if (samples % kShortSlots == 0) total10[l] = totalNow;
+
+    // Forget deleted tasks so their slots can be reused
+    portENTER_CRITICAL(&monMux);
+    for (int i = 0; i < TASK_MON_MAX_TASKS; i++) {
+        if (!tracks[i].seen) tracks[i].handle = nullptr;
+    }
+    portEXIT_CRITICAL(&monMux);
+#else
+    // No system state: stack data for the tasks we created
+    TaskHandle_t handles[TASK_MON_MAX_TASKS];
+    int count = taskTableHandles(handles, TASK_MON_MAX_TASKS);
+    for (int i = 0; i < count; i++) {
+        TaskStat &o = fresh[n++];
+        strncpy(o.name, pcTaskGetName(handles[i]), sizeof(o.name) - 1);
+        o.name[sizeof(o.name) - 1] = '\0';
+        o.core = -1;
+        o.priority = (uint8_t)uxTaskPriorityGet(handles[i]);
+        o.state = '?';
+        o.stackSize = taskStackSize(handles[i]);
+        o.stackFree = uxTaskGetStackHighWaterMark(handles[i]);
+        o.cpu1s = o.cpu10s = o.cpu60s = NAN;
+        o.blockedMs10s = 0;
+        o.switchesPerSec = 0.0f;
+    }
+#endif
+
+    samples++;
+
+    xSemaphoreTake(statsMutex, portMAX_DELAY);
+    memcpy(stats, fresh, n * sizeof(TaskStat));
+    statCount = n;
+    xSemaphoreGive(statsMutex);
+}
+
+/* ====== Public Functions ====== */
+
+void task_monitor(void* pv) {
+#if STATIC_ALLOCATION
+    static StaticSemaphore_t statsMutexBuffer;
+    statsMutex = xSemaphoreCreateMutexStatic(&statsMutexBuffer);
+#else
+    statsMutex = xSemaphoreCreateMutex();
+#endif
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        esp_register_freertos_tick_hook_for_cpu(onTick, core);
+    }
+
+    Serial.printf("[MON] Task monitor started (%s)\n",
+                  MON_RUN_TIME ? "run-time stats" : "stack only");
+
+    for (;;) {
+        sampleTasks();
+        vTaskDelay(pdMS_TO_TICKS(TASK_MON_SAMPLE_MS));
+    }
+}
+
+int taskMonitorSnapshot(TaskStat* dst, int max) {
+    if (statsMutex == nullptr) return 0;
+    xSemaphoreTake(statsMutex, portMAX_DELAY);
+    int n = statCount < max ? statCount : max;
+    memcpy(dst, stats, n * sizeof(TaskStat));
+    xSemaphoreGive(statsMutex);
+    return n;
+}
+
+bool taskMonitorHasRunTime() {
+    return MON_RUN_TIME;
+}
+
+uint32_t taskMonitorSuggestStack(const TaskStat& t) {
+    if (t.stackSize == 0 || t.stackFree > t.stackSize) return 0;
+    uint32_t used = t.stackSize - t.stackFree;
+    uint32_t margin = used / 4 > 512 ? used / 4 : 512;
+    return (used + margin + 255) & ~255u;
+}
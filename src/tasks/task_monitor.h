@@ -0,0 +1,73 @@
+/**
+ * @file task_monitor.h
+ * @brief Task Monitor - Per-task CPU share, stack headroom and wake rate
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * A low-priority MON task samples the scheduler every TASK_MON_SAMPLE_MS
+ * with uxTaskGetSystemState() and keeps, for every task in the system
+ * (including IDLE, WiFi and loopTask):
+ * - CPU share over sliding 1 s / 10 s / 60 s windows (run-time counters)
+ * - Stack high-water mark and, for tasks from the task table, a suggested
+ *   TASK_*_STACK_SIZE (used + 25%, at least 512 bytes margin)
+ * - Time not running over the last 10 s (blocked or waiting for a CPU)
+ * - Switch-ins per second, counted by a tick hook on each core
+ *
+ * Availability:
+ * - CPU share and blocked time need configGENERATE_RUN_TIME_STATS
+ * - The full task list needs configUSE_TRACE_FACILITY; without it only
+ *   the tasks from the task table are listed (stack data only)
+ *
+ * @note Served as JSON by GET /tasks
+ */
+
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * @brief Telemetry for one task (copied out by taskMonitorSnapshot)
+ */
+struct TaskStat {
+    char name[configMAX_TASK_NAME_LEN];   ///< FreeRTOS task name
+    int8_t core;                          ///< Pinned core, -1 = no affinity
+    uint8_t priority;                     ///< Current priority
+    char state;                           ///< R=running r=ready B=blocked S=suspended D=deleted
+    uint32_t stackSize;                   ///< Bytes from the task table, 0 = system task
+    uint32_t stackFree;                   ///< Bytes never touched (high-water mark)
+    float cpu1s;                          ///< % of one core over the last second (NAN = no stats)
+    float cpu10s;                         ///< % of one core over the last 10 s
+    float cpu60s;                         ///< % of one core over the last ~60 s
+    uint32_t blockedMs10s;                ///< Time not running over the last 10 s
+    float switchesPerSec;                 ///< Switch-ins per second over the last 10 s
+};
+
+/**
+ * @brief FreeRTOS task that samples the scheduler (created from the task table)
+ * @param pv Unused parameter (FreeRTOS requirement)
+ */
+void task_monitor(void* pv);
+
+/**
+ * @brief Copy the latest sample
+ * @param dst Destination array
+ * @param max Capacity of dst
+ * @return Number of tasks copied
+ */
+int taskMonitorSnapshot(TaskStat* dst, int max);
+
+/**
+ * @brief true when CPU share / blocked time are measured
+ */
+bool taskMonitorHasRunTime();
+
+/**
+ * @brief Suggested stack size for a task from the task table
+ * @return Bytes (multiple of 256), 0 for system tasks
+ */
+uint32_t taskMonitorSuggestStack(const TaskStat& t);
+
+#endif // TASK_MONITOR_H
@@ -10,13 +10,23 @@
  * - task2_led_neopixel.cpp: LED + NeoPixel control (data consumers, wait for semaphores)
  * - task3_lcd.cpp: LCD display (data consumer, waits for semaphore)
  * - task5_tinyml.cpp: TinyML inference (independent processor)
+ * - executor.cpp: cooperative executor hosting tasks 1-5 as jobs (EXECUTOR_MODE)
  * 
- * All tasks are pinned to APP_CPU_NUM (tskNO_AFFINITY) for automatic load balancing.
+ * Every task is described by one row of kTaskTable; its core comes from the
+ * placement profile selected by TASK_PLACEMENT_PROFILE (see config.h).
  */
 
 #include "tasks.h"
 #include "../config/config.h"
 #include "../ml/tinyml.h"
+#include "../web/web_server.h"
+#include "deferred_log.h"
+#include "executor.h"
+#include "latency_bench.h"
+#include "led_service.h"
+#include "placement_bench.h"
+#include "power_manager.h"
+#include "task_monitor.h"
 
 /* ====== Task Function Prototypes ====== */
 
@@ -50,90 +60,172 @@ extern void task_neopixel_ui(void* pv);
  */
 extern void task_lcd(void* pv);
 
+/* ====== Task Table ====== */
+
+/**
+ * @brief Static description of one FreeRTOS task
+ */
+struct TaskDescriptor {
+    TaskFunction_t fn;        ///< Task function
+    const char* name;         ///< Task name (for debugging)
+    uint32_t stack;           ///< Stack size in bytes
+    UBaseType_t priority;     ///< FreeRTOS priority
+    BaseType_t core;          ///< Core from the placement profile (or tskNO_AFFINITY)
+    bool enabled;             ///< Created by createAllTasks()
+};
+
+/**
+ * @brief Every task in the system, in creation order
+ * @note The data source (DHT20) is created first so its semaphores are
+ *       given before any consumer starts waiting
+ * @note With EXECUTOR_MODE the five sensing tasks are replaced by the
+ *       single EXEC task that runs the same step functions
+ * @note With LED_SERVICE, NEO_H and NEO_UI are replaced by the LEDS task
+ */
+static constexpr TaskDescriptor kTaskTable[] = {
+    // fn                 name      stack                    priority              core          enabled
+    { task_read_dht20,    "DHT20",  TASK_DHT_STACK_SIZE,     TASK_DHT_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE },
+    { task_led,           "LED",    TASK_LED_STACK_SIZE,     TASK_LED_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE },
+    { task_neopixel_hum,  "NEO_H",  TASK_NEO_HUM_STACK_SIZE, TASK_NEO_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE && !LED_SERVICE },
+    { task_neopixel_ui,   "NEO_UI", TASK_NEO_UI_STACK_SIZE,  TASK_LCD_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE && !LED_SERVICE },
+    { task_led_service,   "LEDS",   TASK_LEDS_STACK_SIZE,    TASK_NEO_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE && LED_SERVICE },
+    { task_lcd,           "LCD",    TASK_LCD_STACK_SIZE,     TASK_LCD_PRIORITY,    CORE_SENSING, !EXECUTOR_MODE },
+    { task_executor,      "EXEC",   TASK_EXEC_STACK_SIZE,    TASK_EXEC_PRIORITY,   CORE_SENSING, EXECUTOR_MODE },
+    { tiny_ml_task,       "TinyML", TASK_TINYML_STACK_SIZE,  TASK_TINYML_PRIORITY, CORE_COMPUTE, true },
+    { task_web,           "WEB",    TASK_WEB_STACK_SIZE,     TASK_WEB_PRIORITY,    CORE_NETWORK, TASK_WEB_IN_TASK },
+    { task_monitor,       "MON",    TASK_MON_STACK_SIZE,     TASK_MON_PRIORITY,    CORE_COMPUTE, TASK_MONITOR_ENABLED },
+    { task_log,           "LOG",    TASK_LOG_STACK_SIZE,     TASK_LOG_PRIORITY,    CORE_COMPUTE, DEFERRED_LOG_ENABLED },
+    { task_power,         "PWR",    TASK_PWR_STACK_SIZE,     TASK_PWR_PRIORITY,    CORE_COMPUTE, POWER_MGMT_ENABLED },
+#if EXECUTOR_BENCH
+    { task_exec_bench,    "EXB",    3072,                    TASK_MON_PRIORITY,    tskNO_AFFINITY, true },
+#endif
+#if TASK_PLACEMENT_BENCH
+    // Placement benchmark: one burner pinned to each core + loopback HTTP client
+    { task_bench_load,    "LOAD0",  2048,                    TASK_BENCH_LOAD_PRIORITY, 0,      true },
+    { task_bench_load,    "LOAD1",  2048,                    TASK_BENCH_LOAD_PRIORITY, 1,      true },
+    { task_bench_http,    "HTTPB",  4096,                    TASK_WEB_PRIORITY,    CORE_NETWORK, true },
+#endif
+#if LATENCY_BENCH
+    // Latency benchmark: edge stimulus, report, optional HTTP flood and burners
+    { task_lat_stimulus,  "LATS",   2048,                    TASK_DHT_PRIORITY,    CORE_SENSING, true },
+    { task_lat_report,    "LATR",   3072,                    TASK_MON_PRIORITY,    tskNO_AFFINITY, true },
+    { task_lat_http,      "LHTTP",  4096,                    TASK_WEB_PRIORITY,    CORE_NETWORK, (LATENCY_BENCH_LOAD & LAT_LOAD_HTTP) != 0 },
+    { task_bench_load,    "LOAD0",  2048,                    TASK_BENCH_LOAD_PRIORITY, 0,      (LATENCY_BENCH_LOAD & LAT_LOAD_CPU) != 0 },
+    { task_bench_load,    "LOAD1",  2048,                    TASK_BENCH_LOAD_PRIORITY, 1,      (LATENCY_BENCH_LOAD & LAT_LOAD_CPU) != 0 },
+#endif
+};
+
+static constexpr int kTaskCount = sizeof(kTaskTable) / sizeof(kTaskTable[0]);
+
+/**
+ * @brief Handles of the created tasks (nullptr = disabled or failed)
+ */
+static TaskHandle_t taskHandles[kTaskCount];
+
+#if STATIC_ALLOCATION
+/**
+ * @brief Total stack bytes of the enabled tasks
+ */
+static constexpr uint32_t staticStackBytes() {
+    uint32_t total = 0;
+    for (const TaskDescriptor& t : kTaskTable) {
+        if (t.enabled) total += t.stack;
+    }
+    return total;
+}
+
+/**
+ * @brief Stacks and TCBs for every enabled task (carved in table order)
+ */
+alignas(16) static StackType_t taskStackPool[staticStackBytes() / sizeof(StackType_t)];
+static StaticTask_t taskTcbs[kTaskCount];
+#endif
+
+/**
+ * @brief Profile name for the startup log
+ */
+static const char* placementName() {
+    switch (TASK_PLACEMENT_PROFILE) {
+        case PLACEMENT_SPLIT:  return "SPLIT (sensing core 1, network core 0)";
+        case PLACEMENT_PACKED: return "PACKED (all core 1)";
+        default:               return "FLOAT (no affinity)";
+    }
+}
+
 /* ====== Task Creation ====== */
 
 /**
  * @brief Create all FreeRTOS tasks for the system
- * @details Creates 6 concurrent tasks:
+ * @details Walks kTaskTable and creates every enabled entry:
  *          1. DHT20 sensor (Priority 3 - highest)
  *          2. LED control (Priority 2)
  *          3. NeoPixel humidity (Priority 2)
  *          4. NeoPixel UI bar (Priority 1)
  *          5. LCD display (Priority 1)
  *          6. TinyML inference (Priority 1)
+ *          7. HTTP server (Priority 1, only when TASK_WEB_IN_TASK)
+ *          8. Task monitor (Priority 1, when TASK_MONITOR_ENABLED)
+ *          9. Deferred logger (Priority 0, when DEFERRED_LOG_ENABLED)
+ *          (1-5 become the single EXEC task when EXECUTOR_MODE is set)
  * 
- * @note Tasks are pinned using xTaskCreatePinnedToCore() with APP_CPU_NUM
+ * @note Tasks are pinned using xTaskCreatePinnedToCore() with the core
+ *       of the selected placement profile (xTaskCreateStaticPinnedToCore()
+ *       with stacks from taskStackPool when STATIC_ALLOCATION is set)
  * @note All tasks run in infinite loops and never return
  * @warning Call this AFTER hardware and semaphore initialization
  * @warning Do not call this multiple times (will create duplicate tasks)
  */
 void createAllTasks() {
-    Serial.println("[TASKS] Creating FreeRTOS tasks...");
-    
-    // Task 1: DHT20 Sensor Reader (highest priority - data source)
-    // Reads temperature/humidity every 500ms and signals dependent tasks
-    xTaskCreatePinnedToCore(
-        task_read_dht20,          // Task function
-        "DHT20",                  // Task name (for debugging)
-        TASK_DHT_STACK_SIZE,      // Stack size: 4096 bytes
-        nullptr,                  // Task parameter (unused)
-        TASK_DHT_PRIORITY,        // Priority: 3 (highest)
-        nullptr,                  // Task handle (not needed)
-        APP_CPU_NUM               // CPU core: tskNO_AFFINITY (auto-balance)
-    );
-    
-    // Task 2: LED Temperature Indicator (high priority - time-sensitive)
-    // Blinks LED at different rates based on temperature band
-    xTaskCreatePinnedToCore(
-        task_led,                 // Task function
-        "LED",                    // Task name
-        TASK_LED_STACK_SIZE,      // Stack size: 3072 bytes
-        nullptr,                  // Task parameter (unused)
-        TASK_LED_PRIORITY,        // Priority: 2 (high)
-        nullptr,                  // Task handle (not needed)
-        APP_CPU_NUM               // CPU core: tskNO_AFFINITY
-    );
-    
-    // Task 3: NeoPixel Humidity Indicator (high priority - time-sensitive)
-    // Single LED shows humidity level via color (blue → green → yellow → red)
-    xTaskCreatePinnedToCore(
-        task_neopixel_hum,        // Task function
-        "NEO_H",                  // Task name
-        TASK_NEO_HUM_STACK_SIZE,  // Stack size: 3072 bytes
-        nullptr,                  // Task parameter (unused)
-        TASK_NEO_PRIORITY,        // Priority: 2 (high)
-        nullptr,                  // Task handle (not needed)
-        APP_CPU_NUM               // CPU core: tskNO_AFFINITY
-    );
-    
-    // Task 4: NeoPixel UI Bar (low priority - user interface)
-    // 4-LED strip with modes: OFF, BAR, DEMO, SOS, BLINK
-    xTaskCreatePinnedToCore(
-        task_neopixel_ui,         // Task function
-        "NEO_UI",                 // Task name
-        TASK_NEO_UI_STACK_SIZE,   // Stack size: 3072 bytes
-        nullptr,                  // Task parameter (unused)
-        TASK_LCD_PRIORITY,        // Priority: 1 (low)
-        nullptr,                  // Task handle (not needed)
-        APP_CPU_NUM               // CPU core: tskNO_AFFINITY
-    );
-    
-    // Task 5: LCD Display (low priority - display updates)
-    // 16x2 LCD shows temperature, humidity, and status
-    xTaskCreatePinnedToCore(
-        task_lcd,                 // Task function
-        "LCD",                    // Task name
-        TASK_LCD_STACK_SIZE,      // Stack size: 3072 bytes
-        nullptr,                  // Task parameter (unused)
-        TASK_LCD_PRIORITY,        // Priority: 1 (low)
-        nullptr,                  // Task handle (not needed)
-        APP_CPU_NUM               // CPU core: tskNO_AFFINITY
-    );
-
-    // Task 6: TinyML Anomaly Detection (low priority - ML inference)
-    // Runs TensorFlow Lite Micro model for anomaly detection
-    // Created by separate function in task5_tinyml.cpp
-    createTinyMLTask();
-    
+    Serial.printf("[TASKS] Creating FreeRTOS tasks, placement %s\n", placementName());
+#if STATIC_ALLOCATION
+    StackType_t* stackNext = taskStackPool;
+#endif
+
+    for (int i = 0; i < kTaskCount; i++) {
+        const TaskDescriptor& t = kTaskTable[i];
+        if (!t.enabled) continue;
+
+#if STATIC_ALLOCATION
+        taskHandles[i] = xTaskCreateStaticPinnedToCore(
+            t.fn, t.name, t.stack, nullptr, t.priority, stackNext, &taskTcbs[i], t.core);
+        stackNext += t.stack / sizeof(StackType_t);
+        BaseType_t created = taskHandles[i] != nullptr ? pdPASS : pdFAIL;
+#else
+        BaseType_t created = xTaskCreatePinnedToCore(
+            t.fn, t.name, t.stack, nullptr, t.priority, &taskHandles[i], t.core);
+#endif
+
+        if (created != pdPASS) {
+            Serial.printf("[TASKS] ✗ Failed to create %s\n", t.name);
+            continue;
+        }
+        if (t.core == tskNO_AFFINITY) {
+            Serial.printf("[TASKS] %-6s prio %u stack %5u core any\n",
+                          t.name, (unsigned)t.priority, (unsigned)t.stack);
+        } else {
+            Serial.printf("[TASKS] %-6s prio %u stack %5u core %d\n",
+                          t.name, (unsigned)t.priority, (unsigned)t.stack, (int)t.core);
+        }
+    }
+
+#if STATIC_ALLOCATION
+    Serial.printf("[TASKS] Static allocation: %u bytes of stacks + %u bytes of TCBs in .bss\n",
+                  (unsigned)sizeof(taskStackPool), (unsigned)sizeof(taskTcbs));
+#endif
     Serial.println("[TASKS] All tasks created successfully");
 }
+
+uint32_t taskStackSize(TaskHandle_t h) {
+    for (int i = 0; i < kTaskCount; i++) {
+        if (h != nullptr && taskHandles[i] == h) return kTaskTable[i].stack;
+    }
+    return 0;
+}
+
+int taskTableHandles(TaskHandle_t* out, int max) {
+    int n = 0;
+    for (int i = 0; i < kTaskCount && n < max; i++) {
+        if (taskHandles[i] != nullptr) out[n++] = taskHandles[i];
+    }
+    return n;
+}
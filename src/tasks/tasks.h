@@ -111,16 +111,38 @@ void task_lcd(void* pv);
 /* ====== Task Management ====== */
 
 /**
- * @brief Creates all FreeRTOS tasks with proper priorities and core affinity
+ * @brief Creates all FreeRTOS tasks from the task table (tasks.cpp)
  * 
- * Task Configuration:
- * - Task 1 (DHT20): Core 1, Priority 3, Stack 4096
- * - Task 2 (LED): Core 0, Priority 2, Stack 3072
- * - Task 3 (NeoPixel Hum): Core 0, Priority 2, Stack 3072
- * - Task 4 (NeoPixel UI): Core 0, Priority 1, Stack 3072
- * - Task 5 (LCD): Core 0, Priority 1, Stack 3072
- * - Task 6 (TinyML): Core 0, Priority 1, Stack 8192
+ * Task Configuration (core group → core per TASK_PLACEMENT_PROFILE):
+ * - Task 1 (DHT20): Sensing, Priority 3, Stack 4096
+ * - Task 2 (LED): Sensing, Priority 2, Stack 3072
+ * - Task 3 (NeoPixel Hum): Sensing, Priority 2, Stack 3072
+ * - Task 4 (NeoPixel UI): Sensing, Priority 1, Stack 3072
+ * - Task 5 (LCD): Sensing, Priority 1, Stack 3072
+ * - Task 6 (TinyML): Compute, Priority 1, Stack 8192
+ * - WEB (HTTP server): Network, Priority 1, Stack 6144 (split/packed only)
+ * - MON (task monitor): Compute, Priority 1, Stack 3072
+ * - LOG (deferred logger): Compute, Priority 0, Stack 3072
+ * - EXEC (EXECUTOR_MODE=1 only): Sensing, Priority 3, Stack 4096, replaces
+ *   Tasks 1-5 and runs their step functions cooperatively (executor.h)
+ * - LEDS (LED_SERVICE=1): Sensing, Priority 2, Stack 3072, replaces
+ *   Tasks 3 and 4 (led_service.h)
  */
 void createAllTasks();
 
+/**
+ * @brief Stack size a task was created with from the task table
+ * @param h Task handle
+ * @return Bytes, 0 if the task is not from the table (IDLE, WiFi, ...)
+ */
+uint32_t taskStackSize(TaskHandle_t h);
+
+/**
+ * @brief Handles of every task created from the task table
+ * @param out Destination array
+ * @param max Capacity of out
+ * @return Number of handles written
+ */
+int taskTableHandles(TaskHandle_t* out, int max);
+
 #endif // TASKS_H
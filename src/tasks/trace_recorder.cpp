@@ -0,0 +1,193 @@
+/**
+ * @file trace_recorder.cpp
+ * @brief Trace Recorder - Implementation
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Writers claim a slot with one atomic increment and fill it; nothing
+ * blocks, so the tick hook and every task can record concurrently. The
+ * dump pauses recording (events recorded meanwhile are counted as
+ * dropped) and waits one tick so in-flight writers finish their slot.
+ */
+
+#include "trace_recorder.h"
+#include "tasks.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_freertos_hooks.h"
+#include "esp_timer.h"
+#include <atomic>
+
+static_assert((TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) == 0, "TRACE_BUFFER_EVENTS must be a power of two");
+
+#define TRACE_SYSTEM_STATE (configUSE_TRACE_FACILITY == 1)
+
+/* ====== Local State ====== */
+
+namespace {
+    constexpr uint16_t kDumpVersion = 1;
+    constexpr size_t kNameLen = 16;          ///< Label / task name field in the dump
+
+    DRAM_ATTR TraceEvent events[TRACE_BUFFER_EVENTS];
+    std::atomic<uint32_t> writeIdx{0};       ///< Events recorded since the last clear
+    std::atomic<uint32_t> pausedDrops{0};    ///< Events lost while a dump was running
+    volatile bool paused = false;
+
+    const char* labels[TRACE_MAX_LABELS];
+    uint8_t labelCount = 0;
+    portMUX_TYPE labelMux = portMUX_INITIALIZER_UNLOCKED;
+
+    TaskHandle_t lastOnCpu[portNUM_PROCESSORS];   ///< Tick hook: task seen at the previous tick
+    uint32_t ticksSinceSync[portNUM_PROCESSORS];
+
+#if TRACE_SYSTEM_STATE
+    TaskStatus_t status[TASK_MON_MAX_TASKS];      ///< Task names for the dump
+#endif
+
+    /**
+     * @brief Claim a slot and fill it
+     */
+    inline void IRAM_ATTR record(TraceType type, uint8_t label, uint32_t arg) {
+        if (paused) {
+            pausedDrops.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        uint32_t i = writeIdx.fetch_add(1, std::memory_order_relaxed);
+        TraceEvent& e = events[i & (TRACE_BUFFER_EVENTS - 1)];
+        e.cycles = ESP.getCycleCount();
+        e.type = type;
+        e.core = (uint8_t)xPortGetCoreID();
+        e.label = label;
+        e.reserved = 0;
+        e.arg = arg;
+    }
+
+    /**
+     * @brief Task switches (tick resolution) and per-core time sync
+     */
+    void IRAM_ATTR onTraceTick() {
+        int core = xPortGetCoreID();
+        TaskHandle_t cur = xTaskGetCurrentTaskHandle();
+        if (cur != lastOnCpu[core]) {
+            lastOnCpu[core] = cur;
+            record(TRACE_SWITCH, kTraceNoLabel, (uint32_t)cur);
+        }
+        if (++ticksSinceSync[core] >= TRACE_SYNC_TICKS) {
+            ticksSinceSync[core] = 0;
+            record(TRACE_SYNC, kTraceNoLabel, (uint32_t)esp_timer_get_time());
+        }
+    }
+
+    void putU16(uint8_t* p, uint16_t v) { memcpy(p, &v, 2); }   // Xtensa is little endian
+    void putU32(uint8_t* p, uint32_t v) { memcpy(p, &v, 4); }
+
+    void putName(uint8_t* p, const char* name) {
+        memset(p, 0, kNameLen);
+        if (name) strncpy((char*)p, name, kNameLen - 1);
+    }
+} // namespace
+
+/* ====== Public Functions ====== */
+
+void traceInit() {
+#if TRACE_ENABLED
+    // Cost per event, measured on an empty buffer and discarded
+    constexpr int kProbe = 64;
+    uint32_t c0 = ESP.getCycleCount();
+    for (int i = 0; i < kProbe; i++) traceRecord(TRACE_SYNC, kTraceNoLabel);
+    uint32_t cycles = (ESP.getCycleCount() - c0) / kProbe;
+    writeIdx.store(0);
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        esp_register_freertos_tick_hook_for_cpu(onTraceTick, core);
+    }
+
+    Serial.printf("[TRACE] Recorder ready: %d events x %u bytes, ~%u cycles/event\n",
+                  TRACE_BUFFER_EVENTS, (unsigned)sizeof(TraceEvent), (unsigned)cycles);
+#endif
+}
+
+uint8_t traceLabel(const char* name) {
+    uint8_t id = kTraceNoLabel;
+    portENTER_CRITICAL(&labelMux);
+    for (uint8_t i = 0; i < labelCount; i++) {
+        if (labels[i] == name || strcmp(labels[i], name) == 0) {
+            id = i;
+            break;
+        }
+    }
+    if (id == kTraceNoLabel && labelCount < TRACE_MAX_LABELS) {
+        labels[labelCount] = name;
+        id = labelCount++;
+    }
+    portEXIT_CRITICAL(&labelMux);
+    return id;
+}
+
+#if TRACE_ENABLED
+void IRAM_ATTR traceRecord(TraceType type, uint8_t label) {
+    record(type, label, (uint32_t)xTaskGetCurrentTaskHandle());
+}
+#endif
+
+void traceWrite(void (*sink)(const uint8_t* data, size_t len, void* ctx), void* ctx, bool clear) {
+    paused = true;
+    vTaskDelay(1);  // Let writers that claimed a slot finish it
+
+    uint32_t total = writeIdx.load();
+    uint32_t count = total < TRACE_BUFFER_EVENTS ? total : TRACE_BUFFER_EVENTS;
+    uint32_t first = total - count;
+    uint32_t dropped = (total - count) + pausedDrops.load();
+
+    // Task names (handles recorded in arg)
+#if TRACE_SYSTEM_STATE
+    uint32_t totalRunTime;
+    int taskCount = (int)uxTaskGetSystemState(status, TASK_MON_MAX_TASKS, &totalRunTime);
+#else
+    TaskHandle_t handles[TASK_MON_MAX_TASKS];
+    int taskCount = taskTableHandles(handles, TASK_MON_MAX_TASKS);
+#endif
+
+    // Header
+    uint8_t header[24];
+    memcpy(header, "ETRC", 4);
+    putU16(header + 4, kDumpVersion);
+    putU16(header + 6, sizeof(TraceEvent));
+    putU32(header + 8, ESP.getCpuFreqMHz());   // Rate now; SYNC intervals give the rate then
+    putU32(header + 12, count);
+    putU32(header + 16, dropped);
+    putU16(header + 20, labelCount);
+    putU16(header + 22, (uint16_t)taskCount);
+    sink(header, sizeof(header), ctx);
+
+    // Labels
+    uint8_t entry[4 + kNameLen];
+    for (uint8_t i = 0; i < labelCount; i++) {
+        putName(entry, labels[i]);
+        sink(entry, kNameLen, ctx);
+    }
+
+    // Tasks
+    for (int i = 0; i < taskCount; i++) {
+#if TRACE_SYSTEM_STATE
+        putU32(entry, (uint32_t)status[i].xHandle);
+        putName(entry + 4, status[i].pcTaskName);
+#else
+        putU32(entry, (uint32_t)handles[i]);
+        putName(entry + 4, pcTaskGetName(handles[i]));
+#endif
+        sink(entry, sizeof(entry), ctx);
+    }
+
+    // Events, oldest first (at most two contiguous runs of the ring)
+    uint32_t start = first & (TRACE_BUFFER_EVENTS - 1);
+    uint32_t run = count < TRACE_BUFFER_EVENTS - start ? count : TRACE_BUFFER_EVENTS - start;
+    if (run > 0) sink((const uint8_t*)&events[start], run * sizeof(TraceEvent), ctx);
+    if (count > run) sink((const uint8_t*)&events[0], (count - run) * sizeof(TraceEvent), ctx);
+
+    if (clear) {
+        writeIdx.store(0);
+        pausedDrops.store(0);
+    }
+    paused = false;
+}
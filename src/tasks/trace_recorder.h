@@ -0,0 +1,106 @@
+/**
+ * @file trace_recorder.h
+ * @brief Trace Recorder - Timestamped binary event trace (flight recorder)
+ * @author ESP32-S3 Lab
+ * @date 2025
+ *
+ * Every event is a 12-byte record (CPU cycle counter, type, core, label,
+ * argument) written into a RAM ring of TRACE_BUFFER_EVENTS entries; the
+ * oldest events are overwritten. Recording is one atomic increment plus
+ * three stores, so the recorder stays enabled in normal builds.
+ *
+ * Recorded events:
+ *   GIVE / TAKE        executor events (semBandChanged, semHumChanged,
+ *                      semLcdUpdate) at signalEvent() and consumer wake-up
+ *   RUN_BEGIN / END    one job step (runAsTask / executor)
+ *   SWITCH             task now running on a core (tick hook, 1 ms resolution)
+ *   I2C_BEGIN / END    DHT20 read, LCD refresh
+ *   HTTP_BEGIN / END   one HTTP route handler
+ *   SYNC               esp_timer µs per core every TRACE_SYNC_TICKS, used by
+ *                      the converter to align the per-core cycle counters
+ *                      and to derive their rate per interval (the CPU
+ *                      frequency changes under power management)
+ *
+ * GET /trace returns the binary dump (format below); convert it with
+ *   python tools/trace2perfetto.py trace.bin trace.json
+ * and open the JSON in ui.perfetto.dev or chrome://tracing.
+ *
+ * Dump format (little endian):
+ *   header  "ETRC", u16 version, u16 event size, u32 CPU MHz at dump time
+ *           (only a fallback for a core with a single SYNC), u32 events,
+ *           u32 dropped, u16 labels, u16 tasks
+ *   labels  labels x char[16]
+ *   tasks   tasks x (u32 handle, char[16] name)
+ *   events  events x TraceEvent, oldest first
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "../config/config.h"
+
+/**
+ * @brief Event types (stored in TraceEvent::type)
+ */
+enum TraceType : uint8_t {
+    TRACE_SYNC = 0,      ///< arg = esp_timer µs (low 32 bits)
+    TRACE_SWITCH,        ///< arg = task handle running on this core
+    TRACE_GIVE,          ///< label = event, arg = producer task handle
+    TRACE_TAKE,          ///< label = event, arg = consumer task handle
+    TRACE_RUN_BEGIN,     ///< label = job, arg = task handle
+    TRACE_RUN_END,
+    TRACE_I2C_BEGIN,     ///< label = device, arg = task handle
+    TRACE_I2C_END,
+    TRACE_HTTP_BEGIN,    ///< label = route, arg = task handle
+    TRACE_HTTP_END
+};
+
+/**
+ * @brief One trace record (12 bytes)
+ */
+struct TraceEvent {
+    uint32_t cycles;     ///< CPU cycle counter of the recording core
+    uint8_t type;        ///< TraceType
+    uint8_t core;        ///< Recording core
+    uint8_t label;       ///< traceLabel() index, 0xFF = none
+    uint8_t reserved;
+    uint32_t arg;        ///< Type-specific (see TraceType)
+};
+
+static_assert(sizeof(TraceEvent) == 12, "TraceEvent layout is part of the dump format");
+
+constexpr uint8_t kTraceNoLabel = 0xFF;
+
+/**
+ * @brief Register the tick hooks and measure the cost per event
+ * @note Call once from setup() before createAllTasks()
+ */
+void traceInit();
+
+/**
+ * @brief Intern a label (job, event, device or route name)
+ * @param name String literal or other string that outlives the trace
+ * @return Label index, kTraceNoLabel when the table is full
+ * @note Task context only; call once and keep the index
+ */
+uint8_t traceLabel(const char* name);
+
+#if TRACE_ENABLED
+/**
+ * @brief Record one event tagged with the current task (ISR safe)
+ */
+void traceRecord(TraceType type, uint8_t label);
+#else
+inline void traceRecord(TraceType, uint8_t) {}
+#endif
+
+/**
+ * @brief Stream the dump through a sink; recording pauses meanwhile
+ * @param sink Called with consecutive chunks of the dump
+ * @param ctx Passed through to sink
+ * @param clear Discard the recorded events afterwards
+ */
+void traceWrite(void (*sink)(const uint8_t* data, size_t len, void* ctx), void* ctx, bool clear);
+
+#endif // TRACE_RECORDER_H
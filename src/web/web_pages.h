@@ -357,6 +357,10 @@ button:hover { transform:translateY(-1px); box-shadow:0 4px 12px rgba(6,182,212,
           </div>
         </div>
       </div>
+      <div class="small" style="margin-top:10px">Runtime (CPU % over 10 s | stack free / size):</div>
+      <div id="taskStats" class="small" style="font-family:monospace; white-space:pre"></div>
+      <div class="small" style="margin-top:10px">Deadlines (misses | overruns | worst late):</div>
+      <div id="deadlineStats" class="small" style="font-family:monospace; white-space:pre"></div>
     </div>
 
     <!-- TinyML -->
@@ -366,7 +370,7 @@ button:hover { transform:translateY(-1px); box-shadow:0 4px 12px rgba(6,182,212,
       <div class="progress-bar" style="margin:16px 0">
         <div id="tinyProgress" class="progress-fill" style="width:0%; background:linear-gradient(90deg, var(--green), var(--yellow), var(--red))"></div>
       </div>
-      <div class="small">Status: <strong id="tinyStatus">Waiting...</strong> | Runs: <strong id="tinyRuns">0</strong></div>
+      <div class="small">Status: <strong id="tinyStatus">Waiting...</strong> | Runs: <strong id="tinyRuns">0</strong> | Source: <strong id="tinySource">-</strong></div>
     </div>
   </div>
 
@@ -713,12 +717,13 @@ async function poll(){
     }
 
     // Update TinyML
-    const score = j.tiny_score;
+    const score = (j.anomaly_score === null || j.anomaly_score === undefined) ? NaN : j.anomaly_score;
     if (document.getElementById('tinyProgress')) {
       const scorePercent = Math.min(100, Math.max(0, score * 100));
       document.getElementById('tinyProgress').style.width = scorePercent + '%';
       document.getElementById('tinyScore').textContent = isNaN(score) ? '-' : score.toFixed(3);
       document.getElementById('tinyRuns').textContent = j.tinyml_runs || 0;
+      document.getElementById('tinySource').textContent = j.anomaly_src === 'stat' ? 'Statistical' : 'TinyML';
       
       const statusEl = document.getElementById('tinyStatus');
       if (isNaN(score)) {
@@ -737,7 +742,23 @@ async function poll(){
   }
 }
 
+async function pollTasks(){
+  try{
+    const j = await (await fetch('/tasks')).json();
+    document.getElementById('taskStats').textContent = j.tasks.map(t =>
+      t.name.padEnd(12) + (t.cpu_10s === null ? '   -' : t.cpu_10s.toFixed(1).padStart(5)) + '% | ' +
+      t.stack_free + (t.stack ? ' / ' + t.stack : '')).join('\n');
+    const d = await (await fetch('/deadlines')).json();
+    document.getElementById('deadlineStats').textContent = d.tasks.map(t =>
+      (t.escalated ? '! ' : '  ') + t.name.padEnd(10) + String(t.misses).padStart(5) + ' | ' +
+      String(t.overruns).padStart(5) + ' | ' + (t.max_lateness_us / 1000).toFixed(1) + ' ms').join('\n');
+  }catch(e){
+    // ignore
+  }
+}
+
 setInterval(poll, 500);
+setInterval(pollTasks, 2000);
 
 poll();
 
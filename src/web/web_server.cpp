@@ -2,6 +2,21 @@
 #include "web_pages.h"
 #include "../config/config.h"
 #include "../config/system_types.h"
+#include "../config/config_store.h"
+#include "../ml/model_store.h"
+#include "../ml/model_pipeline.h"
+#include "../tasks/task_monitor.h"
+#include "../tasks/deadline_monitor.h"
+#include "../tasks/trace_recorder.h"
+#include "../tasks/power_manager.h"
+#include "../hardware/neo_compositor.h"
+#include "../hardware/neo_pattern.h"
+#include "../hardware/lcd_shadow.h"
+#include "../hardware/lcd_bus.h"
+#include "../tasks/executor.h"
+#include "../tasks/led_service.h"
+#include "../tasks/lcd_pages.h"
+#include <sys/time.h>
 
 /* ====== Local Objects ====== */
 static WebServer server(80);
@@ -11,6 +26,9 @@ static IPAddress AP_IP(192, 168, 4, 1);
 static IPAddress AP_GW(192, 168, 4, 1);
 static IPAddress AP_MASK(255, 255, 255, 0);
 
+/* ====== Upload State ====== */
+static bool modelUploadOk = false;  ///< Current /ml/model upload has not failed
+
 /* ====== Helper Functions ====== */
 static bool parseFloatSafe(const String& s, float &out) {
     if (s.length() == 0) return false;
@@ -18,6 +36,59 @@ static bool parseFloatSafe(const String& s, float &out) {
     return true;
 }
 
+static String jsonFloat(float v, unsigned int digits) {
+    // NAN/INF are not valid JSON numbers
+    return isfinite(v) ? String(v, digits) : String("null");
+}
+
+/**
+ * @brief Quote a user-supplied string as a JSON string literal
+ */
+static String jsonString(const char* s) {
+    String out = "\"";
+    for (; *s; s++) {
+        char c = *s;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((uint8_t)c < 0x20) {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", (unsigned)(uint8_t)c);
+            out += esc;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+/**
+ * @brief Wrap a route handler with HTTP_BEGIN/END trace events and the WiFi PM lock
+ */
+static WebServer::THandlerFunction traced(const char* uri, void (*fn)()) {
+#if TRACE_ENABLED || POWER_MGMT_ENABLED
+    uint8_t label = traceLabel(uri);
+    return [label, fn]() {
+        pmAcquire(PM_LOCK_WIFI);
+        traceRecord(TRACE_HTTP_BEGIN, label);
+        fn();
+        traceRecord(TRACE_HTTP_END, label);
+        pmRelease(PM_LOCK_WIFI);
+    };
+#else
+    return fn;
+#endif
+}
+
+static void route(const char* uri, void (*fn)()) {
+    server.on(uri, traced(uri, fn));
+}
+
+static void route(const char* uri, HTTPMethod method, void (*fn)()) {
+    server.on(uri, method, traced(uri, fn));
+}
+
 /* ====== HTTP Route Handlers ====== */
 
 static void handleIndex() {
@@ -34,16 +105,23 @@ static void handleState() {
     resp += ",\"led\":" + String(gLive.ledOn ? 1 : 0);
     resp += ",\"blink_on\":" + String(gLive.onMs);
     resp += ",\"blink_off\":" + String(gLive.offMs);
+    resp += ",\"blink_hw\":" + String(LED_BLINK_HW);
+    resp += ",\"blink_edges\":" + String(gLive.led_edges);
+    resp += ",\"blink_jitter_avg_us\":" + String(gLive.led_jitter_avg_us);
+    resp += ",\"blink_jitter_max_us\":" + String(gLive.led_jitter_max_us);
     resp += ",\"giveTemp\":" + String(gLive.giveTemp);
     resp += ",\"takeTemp\":" + String(gLive.takeTemp);
     resp += ",\"giveHum\":" + String(gLive.giveHum);
     resp += ",\"takeHum\":" + String(gLive.takeHum);
-    resp += ",\"tcold\":" + String(T_COLD_MAX, 1);
-    resp += ",\"tnorm\":" + String(T_NORMAL_MAX, 1);
-    resp += ",\"thot\":" + String(T_HOT_MAX, 1);
-    resp += ",\"hdry\":" + String(H_DRY_MAX, 1);
-    resp += ",\"hcomf\":" + String(H_COMF_MAX, 1);
-    resp += ",\"hhum\":" + String(H_HUMID_MAX, 1);
+    {
+        ConfigSnapshot cfg;
+        resp += ",\"tcold\":" + String(cfg->tColdMax, 1);
+        resp += ",\"tnorm\":" + String(cfg->tNormalMax, 1);
+        resp += ",\"thot\":" + String(cfg->tHotMax, 1);
+        resp += ",\"hdry\":" + String(cfg->hDryMax, 1);
+        resp += ",\"hcomf\":" + String(cfg->hComfMax, 1);
+        resp += ",\"hhum\":" + String(cfg->hHumidMax, 1);
+    }
     resp += ",\"dht_last_ms\":" + String(gLive.dht_last_ms);
     resp += ",\"led_last_ms\":" + String(gLive.led_last_ms);
     resp += ",\"neo_last_ms\":" + String(gLive.neo_last_ms);
@@ -55,19 +133,31 @@ static void handleState() {
     resp += ",\"tiny_score\":" + String(gLive.tinyml_score, 3);
     resp += ",\"tiny_last_ms\":" + String(gLive.tinyml_last_ms);
     resp += ",\"tiny_runs\":" + String(gLive.tinyml_runs);
+    // Effective anomaly signal: TinyML when available, statistical detector otherwise
+    bool useTiny = gLive.tinyml_ready && !isnan(gLive.tinyml_score);
+    resp += ",\"stat_score\":" + jsonFloat(gLive.stat_score, 3);
+    resp += ",\"stat_cycles\":" + String(gLive.stat_cycles);
+    resp += ",\"anomaly_score\":" + jsonFloat(useTiny ? gLive.tinyml_score : gLive.stat_score, 3);
+    resp += ",\"anomaly_src\":\"" + String(useTiny ? "tinyml" : "stat") + "\"";
+    resp += ",\"deadline_alert\":" + String(gLive.deadline_alert);
     resp += ",\"uiMode\":" + String(gLive.uiMode);
-    resp += ",\"wifiMode\":\"" + gWifiMode + "\"";
+    resp += ",\"wifiMode\":\"" + String((WiFi.getMode() & WIFI_MODE_STA) ? "sta" : "ap") + "\"";
     resp += "}";
     server.send(200, "application/json", resp);
 }
 
 static void handleSet() {
-    float tcold = T_COLD_MAX;
-    float tnorm = T_NORMAL_MAX;
-    float thot  = T_HOT_MAX;
-    float hdry  = H_DRY_MAX;
-    float hcomf = H_COMF_MAX;
-    float hhum  = H_HUMID_MAX;
+    SysConfig next;
+    {
+        ConfigSnapshot cfg;
+        next = *cfg;
+    }
+    float tcold = next.tColdMax;
+    float tnorm = next.tNormalMax;
+    float thot  = next.tHotMax;
+    float hdry  = next.hDryMax;
+    float hcomf = next.hComfMax;
+    float hhum  = next.hHumidMax;
 
     bool ok = true;
 
@@ -93,39 +183,60 @@ static void handleSet() {
         return;
     }
 
-    T_COLD_MAX   = tcold;
-    T_NORMAL_MAX = tnorm;
-    T_HOT_MAX    = thot;
-    H_DRY_MAX    = hdry;
-    H_COMF_MAX   = hcomf;
-    H_HUMID_MAX  = hhum;
+    next.tColdMax   = tcold;
+    next.tNormalMax = tnorm;
+    next.tHotMax    = thot;
+    next.hDryMax    = hdry;
+    next.hComfMax   = hcomf;
+    next.hHumidMax  = hhum;
+    configPublish(next);   // Classification switches to the whole new set at once
 
     server.send(200, "text/plain", "Thresholds updated.");
 }
 
+/**
+ * @brief Switch the UI strip mode and wake Task 4 from its keyframe sleep
+ */
+static void setUiMode(uint8_t mode, const char* msg) {
+    gLive.uiMode = mode;
+    signalEvent(EV_UI_MODE);
+    server.send(200, "text/plain", msg);
+}
+
 static void handleUiOff() {
-    gLive.uiMode = 0;
-    server.send(200, "text/plain", "UI strip OFF");
+    setUiMode(0, "UI strip OFF");
 }
 
 static void handleUiBar() {
-    gLive.uiMode = 1;
-    server.send(200, "text/plain", "UI strip BAR");
+    setUiMode(1, "UI strip BAR");
 }
 
 static void handleUiDemo() {
-    gLive.uiMode = 2;
-    server.send(200, "text/plain", "UI strip DEMO");
+    setUiMode(2, "UI strip DEMO");
 }
 
 static void handleUiSos() {
-    gLive.uiMode = 3;
-    server.send(200, "text/plain", "UI strip SOS");
+    setUiMode(3, "UI strip SOS");
 }
 
 static void handleUiBlink() {
-    gLive.uiMode = 4;
-    server.send(200, "text/plain", "UI strip BLINK");
+    setUiMode(4, "UI strip BLINK");
+}
+
+static void handleUiPattern() {
+    if (!server.hasArg("keys")) {
+        server.send(400, "text/plain", "Missing keys parameter (ms:RRGGBB,...)");
+        return;
+    }
+    int n = neoPatternUpload(server.arg("keys").c_str());
+    if (n < 0) {
+        server.send(400, "text/plain", "Invalid keys: expected 1-" + String(NEO_PATTERN_MAX_KEYS)
+                    + " keyframes ms:RRGGBB (ms 1-60000), comma separated");
+        return;
+    }
+    gLive.uiMode = 5;
+    signalEvent(EV_UI_MODE);
+    server.send(200, "text/plain", "UI strip PATTERN (" + String(n) + " keyframes)");
 }
 
 static void handleFireAlert() {
@@ -146,6 +257,47 @@ static void handleFireAlert() {
     }
 }
 
+/**
+ * @brief Start the default access point
+ */
+static void startAccessPoint(const char* ssid, const char* pass) {
+    WiFi.mode(WIFI_AP);
+    WiFi.softAPConfig(AP_IP, AP_GW, AP_MASK);
+    WiFi.softAP(ssid, pass, 6, false, 4);
+}
+
+/**
+ * @brief Join a network (max 10 seconds), else fall back to the default AP
+ * @return true when connected
+ */
+static bool startStation(const char* ssid, const char* pass) {
+    Serial.println("[WiFi] Switching to Station mode...");
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(ssid, pass);
+
+    // Wait for connection (max 10 seconds)
+    int attempts = 0;
+    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
+        delay(500);
+        Serial.print(".");
+        attempts++;
+    }
+    Serial.println();
+
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.printf("[WiFi] Connected to %s\n", ssid);
+        Serial.print("[WiFi] IP address: ");
+        Serial.println(WiFi.localIP());
+        return true;
+    }
+    Serial.printf("[WiFi] Failed to connect to %s\n", ssid);
+    Serial.println("[WiFi] Reverting to AP mode...");
+    WiFi.disconnect(true);
+    startAccessPoint(AP_SSID_DEFAULT, AP_PASS_DEFAULT);
+    return false;
+}
+
 static void handleWifi() {
     String mode = server.hasArg("mode") ? server.arg("mode") : "ap";
     String ssid = server.hasArg("ssid") ? server.arg("ssid") : "";
@@ -155,46 +307,36 @@ static void handleWifi() {
     Serial.println("  Mode: " + mode);
     Serial.println("  SSID: " + ssid);
 
+    SysConfig next;
+    {
+        ConfigSnapshot cfg;
+        next = *cfg;
+    }
+
     if (mode == "sta") {
         if (ssid.length() == 0) {
             server.send(400, "text/plain", "Error: SSID required for Station mode");
             return;
         }
+        if (ssid.length() >= sizeof(next.staSsid) || pass.length() >= sizeof(next.staPass)) {
+            server.send(400, "text/plain", "Error: SSID max 32, password max 64 characters");
+            return;
+        }
         
         server.send(200, "text/plain", "Connecting to " + ssid + "... Check serial monitor for status. You may need to reconnect.");
         delay(100); // Let response send
         
-        gWifiMode = "sta";
-        gStaSsid  = ssid;
-        gStaPass  = pass;
-
-        Serial.println("[WiFi] Switching to Station mode...");
-        WiFi.disconnect(true);
-        WiFi.mode(WIFI_STA);
-        WiFi.begin(gStaSsid.c_str(), gStaPass.c_str());
-        
-        // Wait for connection (max 10 seconds)
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
-        Serial.println();
-        
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println("[WiFi] Connected to " + ssid);
-            Serial.print("[WiFi] IP address: ");
-            Serial.println(WiFi.localIP());
+        // Only a network that accepted us is restored at boot
+        if (startStation(ssid.c_str(), pass.c_str())) {
+            memset(next.staSsid, 0, sizeof(next.staSsid));
+            memset(next.staPass, 0, sizeof(next.staPass));
+            strncpy(next.staSsid, ssid.c_str(), sizeof(next.staSsid) - 1);
+            strncpy(next.staPass, pass.c_str(), sizeof(next.staPass) - 1);
+            next.wifiMode = CFG_WIFI_STA;
         } else {
-            Serial.println("[WiFi] Failed to connect to " + ssid);
-            Serial.println("[WiFi] Reverting to AP mode...");
-            WiFi.disconnect(true);
-            WiFi.mode(WIFI_AP);
-            WiFi.softAPConfig(AP_IP, AP_GW, AP_MASK);
-            WiFi.softAP(AP_SSID_DEFAULT, AP_PASS_DEFAULT, 6, false, 4);
-            gWifiMode = "ap";
+            next.wifiMode = CFG_WIFI_AP;
         }
+        configPublish(next);
     } else {
         // AP mode - allow custom SSID or use default
         String apSsid = (ssid.length() > 0) ? ssid : String(AP_SSID_DEFAULT);
@@ -203,13 +345,13 @@ static void handleWifi() {
         server.send(200, "text/plain", "Restarting AP mode: " + apSsid + ". Reconnect to new network.");
         delay(100); // Let response send
         
-        gWifiMode = "ap";
+        // Boot restores AP mode with the default SSID; a custom AP is not stored
+        next.wifiMode = CFG_WIFI_AP;
+        configPublish(next);
         Serial.println("[WiFi] Restarting AP mode...");
         WiFi.disconnect(true);
         delay(100);
-        WiFi.mode(WIFI_AP);
-        WiFi.softAPConfig(AP_IP, AP_GW, AP_MASK);
-        WiFi.softAP(apSsid.c_str(), apPass.c_str(), 6, false, 4);
+        startAccessPoint(apSsid.c_str(), apPass.c_str());
         Serial.println("[WiFi] AP mode active");
         Serial.print("[WiFi] SSID: ");
         Serial.println(apSsid);
@@ -236,8 +378,8 @@ static void handleGpio() {
     }
     
     // Prevent control of critical pins
-    if (pin == 11 || pin == 12 || pin == 6 || pin == 45 || pin == 48) {
-        server.send(400, "text/plain", "Cannot control system GPIO pins (I2C, NeoPixel, LED)");
+    if (pin == 11 || pin == 12 || pin == 6 || pin == 45 || pin == 48 || pin == LCD_PAGE_BUTTON_PIN) {
+        server.send(400, "text/plain", "Cannot control system GPIO pins (I2C, NeoPixel, LED, LCD button)");
         return;
     }
     
@@ -249,14 +391,380 @@ static void handleGpio() {
     server.send(200, "text/plain", response);
 }
 
+static void handleModelUpload() {
+    // Called once per chunk - each chunk goes straight to LittleFS
+    HTTPUpload& upload = server.upload();
+    switch (upload.status) {
+        case UPLOAD_FILE_START:
+            Serial.printf("[WEB] Model upload started: %s\n", upload.filename.c_str());
+            modelUploadOk = modelUploadBegin();
+            break;
+        case UPLOAD_FILE_WRITE:
+            if (modelUploadOk) modelUploadOk = modelUploadWrite(upload.buf, upload.currentSize);
+            break;
+        case UPLOAD_FILE_END:
+            if (modelUploadOk) modelUploadOk = modelUploadEnd();
+            else modelUploadAbort();   // Failed write: close the file and drop /model.tmp
+            break;
+        case UPLOAD_FILE_ABORTED:
+            modelUploadAbort();
+            modelUploadOk = false;
+            break;
+    }
+}
+
+static void handleModelUploadDone() {
+    if (!modelUploadOk) {
+        String reason = (const char*)gModelStore.lastError;
+        server.send(400, "text/plain", "Model upload failed" + (reason.length() ? ": " + reason : String("")));
+        return;
+    }
+    server.send(202, "text/plain", "Model staged (" + String(gModelStore.uploadBytes) +
+                " bytes). It is validated and swapped in at the next inference.");
+}
+
+static void handleModelStatus() {
+    String resp = "{";
+    resp += "\"fs\":" + String(gModelStore.fsReady ? 1 : 0);
+    resp += ",\"source\":\"" + String(gModelStore.stored ? "littlefs" : "builtin") + "\"";
+    resp += ",\"bytes\":" + String(gModelStore.activeBytes);
+    resp += ",\"pending\":" + String(modelStagedPending() ? 1 : 0);
+    resp += ",\"swaps\":" + String(gModelStore.swaps);
+    resp += ",\"rejects\":" + String(gModelStore.rejects);
+    resp += ",\"lastError\":\"" + String((const char*)gModelStore.lastError) + "\"";
+    resp += "}";
+    server.send(200, "application/json", resp);
+}
+
+static void handlePipelineStatus() {
+    String resp = "{";
+    resp += "\"arena\":" + String(kPipelineArenaSize);
+    resp += ",\"planned\":" + String(gPipelinePlannedBytes);
+    resp += ",\"models\":[";
+    for (int i = 0; i < PIPE_COUNT; i++) {
+        const PipelineModel& m = gPipeline[i];
+        if (i) resp += ",";
+        resp += "{\"name\":\"" + String(m.name) + "\"";
+        resp += ",\"installed\":" + String(m.data ? 1 : 0);
+        resp += ",\"ready\":" + String(m.ready ? 1 : 0);
+        resp += ",\"runs\":" + String(m.runs);
+        resp += ",\"errors\":" + String(m.errors);
+        resp += ",\"bind_us\":" + String(m.bindUs);
+        resp += ",\"invoke_us\":" + String(m.invokeUs);
+        resp += ",\"max_invoke_us\":" + String(m.maxInvokeUs);
+        resp += ",\"arena_bytes\":" + String(m.arenaBytes);
+        resp += ",\"out\":[";
+        for (int k = 0; k < m.outputs; k++) {
+            if (k) resp += ",";
+            resp += jsonFloat(m.runs ? m.out[k] : NAN, 4);
+        }
+        resp += "]}";
+    }
+    resp += "]}";
+    server.send(200, "application/json", resp);
+}
+
+static void handleTasks() {
+    static TaskStat snap[TASK_MON_MAX_TASKS];  // Static: keeps it off the handler's stack
+    int n = taskMonitorSnapshot(snap, TASK_MON_MAX_TASKS);
+
+    String resp = "{";
+    resp += "\"runtime_stats\":" + String(taskMonitorHasRunTime() ? 1 : 0);
+    resp += ",\"sample_ms\":" + String(TASK_MON_SAMPLE_MS);
+    resp += ",\"tasks\":[";
+    for (int i = 0; i < n; i++) {
+        const TaskStat& t = snap[i];
+        if (i) resp += ",";
+        resp += "{\"name\":\"" + String(t.name) + "\"";
+        resp += ",\"core\":" + String(t.core);
+        resp += ",\"prio\":" + String(t.priority);
+        resp += ",\"state\":\"" + String(t.state) + "\"";
+        resp += ",\"stack\":" + String(t.stackSize);
+        resp += ",\"stack_free\":" + String(t.stackFree);
+        resp += ",\"stack_suggest\":" + String(taskMonitorSuggestStack(t));
+        resp += ",\"cpu_1s\":" + jsonFloat(t.cpu1s, 1);
+        resp += ",\"cpu_10s\":" + jsonFloat(t.cpu10s, 1);
+        resp += ",\"cpu_60s\":" + jsonFloat(t.cpu60s, 1);
+        resp += ",\"blocked_ms_10s\":" + String(t.blockedMs10s);
+        resp += ",\"switches_per_s\":" + jsonFloat(t.switchesPerSec, 1);
+        resp += "}";
+    }
+    resp += "]}";
+    server.send(200, "application/json", resp);
+}
+
+static void handleDeadlines() {
+    DeadlineStat snap[DL_COUNT];
+    int n = deadlineSnapshot(snap, DL_COUNT);
+
+    String resp = "{";
+    resp += "\"escalation\":\"" + String(deadlineEscalationName()) + "\"";
+    resp += ",\"escalate_after\":" + String(DEADLINE_ESCALATE_AFTER);
+    resp += ",\"alert\":" + String(gLive.deadline_alert);
+    resp += ",\"buckets_us\":[";
+    for (int b = 0; b < kDeadlineBuckets - 1; b++) {
+        if (b) resp += ",";
+        resp += String(kDeadlineBucketUs[b]);
+    }
+    resp += "],\"tasks\":[";
+    for (int i = 0; i < n; i++) {
+        const DeadlineStat& d = snap[i];
+        if (i) resp += ",";
+        resp += "{\"name\":\"" + String(d.name) + "\"";
+        resp += ",\"period_ms\":" + String(d.periodMs);
+        resp += ",\"budget_us\":" + String(d.budgetUs);
+        resp += ",\"tolerance_ms\":" + String(d.toleranceMs);
+        resp += ",\"activations\":" + String(d.activations);
+        resp += ",\"misses\":" + String(d.misses);
+        resp += ",\"overruns\":" + String(d.overruns);
+        resp += ",\"max_lateness_us\":" + String(d.maxLatenessUs);
+        resp += ",\"max_exec_us\":" + String(d.maxExecUs);
+        resp += ",\"last_exec_us\":" + String(d.lastExecUs);
+        resp += ",\"streak\":" + String(d.streak);
+        resp += ",\"escalations\":" + String(d.escalations);
+        resp += ",\"escalated\":" + String(d.escalated ? 1 : 0);
+        resp += ",\"lateness_hist\":[";
+        for (int b = 0; b < kDeadlineBuckets; b++) {
+            if (b) resp += ",";
+            resp += String(d.hist[b]);
+        }
+        resp += "]}";
+    }
+    resp += "]}";
+    server.send(200, "application/json", resp);
+}
+
+static void handleNeopixel() {
+    NeoStripStat snap[NEO_STRIP_COUNT];
+    int n = neoStripSnapshot(snap, NEO_STRIP_COUNT);
+
+    String resp = "{\"driver\":\"" + String(neoDriverName()) + "\"";
+    resp += ",\"service\":" + String(LED_SERVICE);
+    resp += ",\"ram_saved\":" + String(ledServiceRamSaved());
+    resp += ",\"strips\":[";
+    for (int i = 0; i < n; i++) {
+        const NeoStripStat& s = snap[i];
+        if (i) resp += ",";
+        resp += "{\"name\":\"" + String(s.name) + "\"";
+        resp += ",\"pixels\":" + String(s.pixels);
+        resp += ",\"rendered\":" + String(s.rendered);
+        resp += ",\"pushed\":" + String(s.pushed);
+        resp += ",\"last_block_us\":" + String(s.lastBlockUs);
+        resp += ",\"max_block_us\":" + String(s.maxBlockUs);
+        resp += ",\"last_wire_us\":" + String(s.lastWireUs);
+        resp += ",\"irq_probed\":" + String(s.probed);
+        resp += ",\"last_irq_off_us\":" + String(s.lastIrqOffUs);
+        resp += ",\"max_irq_off_us\":" + String(s.maxIrqOffUs);
+        resp += ",\"last_render_us\":" + String(s.lastRenderUs);
+        resp += ",\"max_render_us\":" + String(s.maxRenderUs);
+        resp += "}";
+    }
+    resp += "]}";
+    server.send(200, "application/json", resp);
+}
+
+static void handleLcd() {
+    LcdShadowStat s;
+    lcdShadowSnapshot(s);
+    uint32_t n = s.refreshes ? s.refreshes : 1;
+
+    String resp = "{\"bus\":\"" + String(lcdBusName()) + "\"";
+    resp += ",\"page\":\"" + String(lcdPageName(lcdPageCurrent())) + "\"";
+    resp += ",\"rotate_ms\":" + String(LCD_PAGE_ROTATE_MS);
+    resp += ",\"refreshes\":" + String(s.refreshes);
+    resp += ",\"chars\":" + String(s.chars);
+    resp += ",\"cursor_moves\":" + String(s.cursorMoves);
+    resp += ",\"glyph_uploads\":" + String(s.glyphUploads);
+    resp += ",\"last_i2c_bytes\":" + String(s.lastBytes);
+    resp += ",\"max_i2c_bytes\":" + String(s.maxBytes);
+    resp += ",\"avg_i2c_bytes\":" + String((uint32_t)(s.totalBytes / n));
+    resp += ",\"last_full_i2c_bytes\":" + String(s.lastFullBytes);
+    resp += ",\"avg_full_i2c_bytes\":" + String((uint32_t)(s.totalFullBytes / n));
+    resp += ",\"last_flush_us\":" + String(s.lastFlushUs);
+    resp += "}";
+    server.send(200, "application/json", resp);
+}
+
+static void handleLcdPage() {
+    if (!server.hasArg("page")) {
+        lcdPageRequest(kLcdPageNext);
+        server.send(200, "text/plain", "LCD: next page");
+        return;
+    }
+    String arg = server.arg("page");
+    for (int i = 0; i < LCD_PAGE_COUNT; i++) {
+        if (arg == lcdPageName(i) || arg == String(i)) {
+            lcdPageRequest(i);
+            server.send(200, "text/plain", "LCD page " + String(lcdPageName(i)));
+            return;
+        }
+    }
+    server.send(400, "text/plain", "Unknown page: use sensor, trend, ml, net or 0-" + String(LCD_PAGE_COUNT - 1));
+}
+
+static void handleConfig() {
+    ConfigStoreStatus st;
+    configStatus(st);
+    ConfigSnapshot cfg;
+
+    String resp = "{\"schema\":" + String(CONFIG_SCHEMA_VERSION);
+    resp += ",\"source\":\"" + String(st.source) + "\"";
+    resp += ",\"wifi\":\"" + String(configWifiModeName(cfg->wifiMode)) + "\"";
+    resp += ",\"sta_ssid\":" + jsonString(cfg->staSsid);
+    resp += ",\"publishes\":" + String(st.publishes);
+    resp += ",\"saves\":" + String(st.saves);
+    resp += ",\"skipped\":" + String(st.skipped);
+    resp += ",\"failures\":" + String(st.failures);
+    resp += ",\"dirty\":" + String(st.dirty ? "true" : "false");
+    resp += ",\"save_in_ms\":" + String(st.saveInMs);
+    resp += ",\"save_delay_ms\":" + String(CONFIG_SAVE_DELAY_MS);
+    resp += ",\"save_max_delay_ms\":" + String(CONFIG_SAVE_MAX_DELAY_MS);
+    resp += "}";
+    server.send(200, "application/json", resp);
+}
+
+/**
+ * @brief Parse minutes since midnight, as "HH:MM" or a plain number
+ */
+static bool parseMinute(const String& s, uint16_t& out) {
+    int colon = s.indexOf(':');
+    long m = colon < 0 ? s.toInt() : s.substring(0, colon).toInt() * 60 + s.substring(colon + 1).toInt();
+    if (s.length() == 0 || m < 0 || m >= 1440) return false;
+    out = (uint16_t)m;
+    return true;
+}
+
+static void handleBrightness() {
+    NeoBrightness b = neoGetBrightness();
+    bool changed = false;
+
+    if (server.hasArg("level") || server.hasArg("night")) {
+        long day = server.hasArg("level") ? server.arg("level").toInt() : b.day;
+        long night = server.hasArg("night") ? server.arg("night").toInt() : b.night;
+        if (day < 0 || day > 255 || night < 0 || night > 255) {
+            server.send(400, "text/plain", "level and night must be 0-255");
+            return;
+        }
+        b.day = (uint8_t)day;
+        b.night = (uint8_t)night;
+        changed = true;
+    }
+    if (server.hasArg("start") || server.hasArg("end")) {
+        bool ok = true;
+        if (server.hasArg("start")) ok = ok && parseMinute(server.arg("start"), b.nightStartMin);
+        if (server.hasArg("end"))   ok = ok && parseMinute(server.arg("end"), b.nightEndMin);
+        if (!ok) {
+            server.send(400, "text/plain", "start and end must be HH:MM or minutes 0-1439");
+            return;
+        }
+        changed = true;
+    }
+    if (server.hasArg("schedule")) {
+        b.schedule = server.arg("schedule").toInt() != 0;
+        changed = true;
+    }
+    if (server.hasArg("tz")) {
+        long tz = server.arg("tz").toInt();
+        if (tz < -720 || tz > 840) {
+            server.send(400, "text/plain", "tz must be -720..840 minutes from UTC");
+            return;
+        }
+        b.tzMin = (int16_t)tz;
+        changed = true;
+    }
+    if (server.hasArg("epoch")) {
+        // No RTC and no NTP in AP mode: the browser supplies the time
+        struct timeval tv = { (time_t)strtoll(server.arg("epoch").c_str(), nullptr, 10), 0 };
+        settimeofday(&tv, nullptr);
+        changed = true;
+    }
+    if (changed) {
+        neoSetBrightness(b);
+        signalEvent(EV_UI_MODE);    // Repaint now instead of at the next frame
+    }
+
+    String resp = "{\"day\":" + String(b.day);
+    resp += ",\"night\":" + String(b.night);
+    resp += ",\"start\":" + String(b.nightStartMin);
+    resp += ",\"end\":" + String(b.nightEndMin);
+    resp += ",\"schedule\":" + String(b.schedule ? 1 : 0);
+    resp += ",\"tz\":" + String(b.tzMin);
+    uint8_t target = neoBrightnessTarget();
+    uint8_t applied = neoBrightnessLevel();
+    resp += ",\"level\":" + String(target);
+    resp += ",\"applied_level\":" + String(applied);
+    resp += ",\"applied\":" + String(applied == target ? "true" : "false");
+    resp += ",\"gamma\":" + jsonFloat(NEO_GAMMA, 2);
+    resp += ",\"clock\":" + String(neoLocalMinute());
+    resp += "}";
+    server.send(200, "application/json", resp);
+}
+
+static void handlePower() {
+    PowerStat p;
+    if (!powerSnapshot(p)) {
+        server.send(200, "application/json",
+                    POWER_MGMT_ENABLED ? "{\"enabled\":1,\"report\":null}" : "{\"enabled\":0}");
+        return;
+    }
+
+    String resp = "{\"enabled\":1";
+    resp += ",\"active\":" + String(p.active ? 1 : 0);
+    resp += ",\"light_sleep\":\"" + String(p.sleepState) + "\"";
+    resp += ",\"max_mhz\":" + String(p.maxMhz);
+    resp += ",\"min_mhz\":" + String(p.minMhz);
+    resp += ",\"window_ms\":" + String(p.windowMs);
+    resp += ",\"residency\":{\"max\":" + jsonFloat(p.maxPct, 2);
+    resp += ",\"min\":" + jsonFloat(p.minPct, 2);
+    resp += ",\"idle\":" + jsonFloat(p.idlePct, 2) + "}";
+    resp += ",\"est_ma\":" + jsonFloat(p.estMa, 1);
+    resp += ",\"locks\":[";
+    for (int i = 0; i < PM_LOCK_COUNT; i++) {
+        if (i) resp += ",";
+        resp += "{\"name\":\"" + String(pmLockName((PmLockId)i)) + "\"";
+        resp += ",\"held_pct\":" + jsonFloat(p.lockPct[i], 2);
+        resp += ",\"acquires\":" + String(p.lockAcquires[i]) + "}";
+    }
+    resp += "],\"sensor_periods\":" + String(p.periods);
+    resp += ",\"jitter_us\":" + String(p.jitterUs);
+    resp += ",\"jitter_bound_us\":" + String(p.jitterBoundUs);
+    resp += ",\"jitter_violations\":" + String(p.jitterViolations);
+    resp += "}";
+    server.send(200, "application/json", resp);
+}
+
+static void traceSink(const uint8_t* data, size_t len, void* ctx) {
+    server.sendContent((const char*)data, len);
+}
+
+static void handleTrace() {
+    // Chunked: the dump is streamed straight from the trace ring
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.sendHeader("Content-Disposition", "attachment; filename=trace.bin");
+    server.send(200, "application/octet-stream", "");
+    traceWrite(traceSink, nullptr, server.hasArg("clear"));
+    server.sendContent("");
+}
+
+static void handleModelReset() {
+    modelStoreReset();
+    server.send(200, "text/plain", "Reverting to compiled-in model at next inference.");
+}
+
 /* ====== Public Functions ====== */
 
 void initWiFi() {
+    {
+        ConfigSnapshot cfg;
+        if (cfg->wifiMode == CFG_WIFI_STA) {
+            Serial.printf("\n[WiFi] Restoring Station mode (%s)\n", cfg->staSsid);
+            startStation(cfg->staSsid, cfg->staPass);   // Falls back to the default AP
+            return;
+        }
+    }
     Serial.println("\n[WiFi] Initializing Access Point...");
     
-    WiFi.mode(WIFI_AP);
-    WiFi.softAPConfig(AP_IP, AP_GW, AP_MASK);
-    WiFi.softAP(AP_SSID_DEFAULT, AP_PASS_DEFAULT, 6, false, 4);
+    startAccessPoint(AP_SSID_DEFAULT, AP_PASS_DEFAULT);
     
     Serial.print("[WiFi] SSID: ");
     Serial.println(AP_SSID_DEFAULT);
@@ -264,24 +772,36 @@ void initWiFi() {
     Serial.println(AP_PASS_DEFAULT);
     Serial.print("[WiFi] AP IP: ");
     Serial.println(WiFi.softAPIP());
-    
-    gWifiMode = "ap";
 }
 
 void initWebServer() {
     Serial.println("[WEB] Initializing web server...");
     
-    server.on("/", handleIndex);
-    server.on("/state", handleState);
-    server.on("/set", handleSet);
-    server.on("/ui/off", handleUiOff);
-    server.on("/ui/bar", handleUiBar);
-    server.on("/ui/demo", handleUiDemo);
-    server.on("/ui/sos", handleUiSos);
-    server.on("/ui/blink", handleUiBlink);
-    server.on("/fire-alert", handleFireAlert);
-    server.on("/wifi", handleWifi);
-    server.on("/gpio", handleGpio);
+    route("/", handleIndex);
+    route("/state", handleState);
+    route("/set", handleSet);
+    route("/ui/off", handleUiOff);
+    route("/ui/bar", handleUiBar);
+    route("/ui/demo", handleUiDemo);
+    route("/ui/sos", handleUiSos);
+    route("/ui/blink", handleUiBlink);
+    route("/ui/pattern", handleUiPattern);
+    route("/fire-alert", handleFireAlert);
+    route("/wifi", handleWifi);
+    route("/gpio", handleGpio);
+    server.on("/ml/model", HTTP_POST, traced("/ml/model", handleModelUploadDone), handleModelUpload);
+    route("/ml/model", HTTP_GET, handleModelStatus);
+    route("/ml/model/reset", handleModelReset);
+    route("/ml/pipeline", handlePipelineStatus);
+    route("/tasks", handleTasks);
+    route("/deadlines", handleDeadlines);
+    route("/power", handlePower);
+    route("/neopixel", handleNeopixel);
+    route("/brightness", handleBrightness);
+    route("/lcd", handleLcd);
+    route("/lcd/page", handleLcdPage);
+    route("/config", handleConfig);
+    server.on("/trace", handleTrace);   // Not traced: recording is paused while dumping
     
     server.begin();
     
@@ -291,4 +811,13 @@ void initWebServer() {
 
 void handleWebServer() {
     server.handleClient();
+    configService();
+}
+
+void task_web(void* pv) {
+    Serial.printf("[WEB] HTTP server task started on core %d\n", xPortGetCoreID());
+    for (;;) {
+        handleWebServer();
+        vTaskDelay(pdMS_TO_TICKS(HTTP_POLL_MS));  // Same cadence as loop()
+    }
 }
@@ -37,8 +37,9 @@
  *          - Gateway: 192.168.4.1
  *          - Subnet: 255.255.255.0
  *          - Max clients: 4
- * @note Call this once during system setup
- * @note Can be switched to Station mode via web API
+ * @note Call this once during system setup, after configInit()
+ * @note Joins the stored network instead when Station mode was saved
+ *       (POST /wifi); falls back to the AP after 10 seconds
  */
 void initWiFi();
 
@@ -52,6 +53,12 @@ void initWiFi();
  *          - POST /fire-alert: Fire alert control
  *          - POST /wifi      : WiFi configuration
  *          - POST /gpio      : GPIO control
+ *          - POST /ml/model  : Upload anomaly model (multipart, streamed to LittleFS)
+ *          - GET  /ml/model  : Model store status
+ *          - POST /ml/model/reset : Revert to compiled-in model
+ *          - GET  /ml/pipeline : Shared-arena plan and per-model timings
+ *          - GET  /tasks     : Per-task CPU share, stack headroom, switch rate
+ *          - GET  /config    : Config store (NVS) status
  * @note Call this after initWiFi() and before starting main loop
  * @note Server runs on port 80 (HTTP)
  */
@@ -64,8 +71,20 @@ void initWebServer();
  *          per call and returns immediately if no request is pending.
  * @note Non-blocking function - safe to call in tight loop
  * @note Typical usage: Call every 2-10ms in loop()
- * @warning Do not call from FreeRTOS tasks (not thread-safe)
+ * @note Also saves a changed configuration to NVS once the coalescing
+ *       delay has passed (configService())
+ * @warning Call from exactly one context - loop() or task_web(), never
+ *          both (WebServer is not thread-safe)
  */
 void handleWebServer();
 
+/**
+ * @brief FreeRTOS task serving HTTP requests
+ * @param pv Unused parameter (FreeRTOS requirement)
+ * @details Replaces the loop() call to handleWebServer() when
+ *          TASK_WEB_IN_TASK is set, so the server can be pinned to the
+ *          core chosen by TASK_PLACEMENT_PROFILE
+ */
+void task_web(void* pv);
+
 #endif // WEB_SERVER_H
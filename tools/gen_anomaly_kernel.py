@@ -0,0 +1,218 @@
+"""
+gen_anomaly_kernel.py - Extract dense-layer weights from the anomaly model
+
+Parses the TensorFlow Lite flatbuffer embedded in src/ml/dht_anomaly_model.h
+and emits src/ml/dht_anomaly_weights.h with the weights and biases as
+constexpr arrays, for use by the hand-specialized kernel in
+src/ml/dht_anomaly_kernel.h (enabled with -D TINYML_FAST_KERNEL=1).
+
+Supported topology (anything else aborts the build):
+    FULLY_CONNECTED (fused RELU) -> FULLY_CONNECTED (no activation) -> LOGISTIC
+with float32 tensors.
+
+Usage:
+    python tools/gen_anomaly_kernel.py          (standalone)
+    extra_scripts = pre:tools/gen_anomaly_kernel.py   (PlatformIO pre-build)
+"""
+
+import os
+import re
+import struct
+import sys
+
+BUILTIN_FULLY_CONNECTED = 9
+BUILTIN_LOGISTIC = 14
+ACT_NONE = 0
+ACT_RELU = 1
+TENSOR_FLOAT32 = 0
+
+
+class FlatModel:
+    """Minimal read-only view of the TFLite schema (only the fields we need)."""
+
+    def __init__(self, data):
+        self.b = data
+
+    def u32(self, o):
+        return struct.unpack_from("<I", self.b, o)[0]
+
+    def i32(self, o):
+        return struct.unpack_from("<i", self.b, o)[0]
+
+    def field(self, table, index):
+        vtable = table - self.i32(table)
+        vlen = struct.unpack_from("<H", self.b, vtable)[0]
+        if 4 + 2 * index >= vlen:
+            return None
+        off = struct.unpack_from("<H", self.b, vtable + 4 + 2 * index)[0]
+        return table + off if off else None
+
+    def ref(self, o):
+        return o + self.u32(o)
+
+    def vector(self, o):
+        start = self.ref(o)
+        return self.u32(start), start + 4
+
+    def table_vector(self, o):
+        n, s = self.vector(o)
+        return [self.ref(s + 4 * i) for i in range(n)]
+
+    def int_vector(self, o):
+        n, s = self.vector(o)
+        return [self.i32(s + 4 * i) for i in range(n)]
+
+    def byte(self, table, index, default=0):
+        f = self.field(table, index)
+        return self.b[f] if f is not None else default
+
+
+def load_model_bytes(header_path):
+    with open(header_path, "r", encoding="utf-8") as fh:
+        text = fh.read()
+    body = text[text.index("{") + 1:text.rindex("}")]
+    return bytes(int(x, 16) for x in re.findall(r"0x([0-9a-fA-F]{2})", body))
+
+
+def extract_layers(data):
+    m = FlatModel(data)
+    root = m.u32(0)
+
+    version = m.u32(m.field(root, 0))
+    if version != 3:
+        raise ValueError("unsupported schema version %d" % version)
+
+    opcodes = []
+    for oc in m.table_vector(m.field(root, 1)):
+        deprecated = m.byte(oc, 0)
+        f = m.field(oc, 3)
+        opcodes.append(m.i32(f) if f is not None else deprecated)
+
+    buffers = []
+    for buf in m.table_vector(m.field(root, 4)):
+        f = m.field(buf, 0)
+        if f is None:
+            buffers.append(b"")
+        else:
+            n, s = m.vector(f)
+            buffers.append(data[s:s + n])
+
+    subgraph = m.table_vector(m.field(root, 2))[0]
+    tensors = []
+    for t in m.table_vector(m.field(subgraph, 0)):
+        shape = m.int_vector(m.field(t, 0))
+        ttype = m.byte(t, 1, TENSOR_FLOAT32)
+        bf = m.field(t, 2)
+        raw = buffers[m.u32(bf)] if bf is not None else b""
+        tensors.append((shape, ttype, raw))
+
+    ops = []
+    for op in m.table_vector(m.field(subgraph, 3)):
+        f = m.field(op, 0)
+        code = opcodes[m.u32(f) if f is not None else 0]
+        inputs = m.int_vector(m.field(op, 1))
+        act = ACT_NONE
+        opts = m.field(op, 4)
+        if opts is not None:
+            act = m.byte(m.ref(opts), 0, ACT_NONE)
+        ops.append((code, inputs, act))
+
+    codes = [o[0] for o in ops]
+    if codes != [BUILTIN_FULLY_CONNECTED, BUILTIN_FULLY_CONNECTED, BUILTIN_LOGISTIC]:
+        raise ValueError("unsupported topology, builtin ops %s" % codes)
+    if ops[0][2] != ACT_RELU or ops[1][2] != ACT_NONE:
+        raise ValueError("unexpected fused activations")
+
+    layers = []
+    for code, inputs, _ in ops[:2]:
+        w_shape, w_type, w_raw = tensors[inputs[1]]
+        b_shape, b_type, b_raw = tensors[inputs[2]]
+        if w_type != TENSOR_FLOAT32 or b_type != TENSOR_FLOAT32:
+            raise ValueError("only float32 weights are supported")
+        out_dim, in_dim = w_shape
+        weights = struct.unpack("<%df" % (out_dim * in_dim), w_raw)
+        bias = struct.unpack("<%df" % out_dim, b_raw)
+        layers.append((out_dim, in_dim, weights, bias))
+    return layers
+
+
+def fmt_floats(values, indent="    ", per_line=4):
+    items = ["%.9ef" % v for v in values]
+    lines = [", ".join(items[i:i + per_line]) for i in range(0, len(items), per_line)]
+    return (",\n" + indent).join(lines)
+
+
+def render_header(layers):
+    (hidden, inputs, w1, b1), (outputs, hidden2, w2, b2) = layers
+    assert hidden == hidden2 and outputs == 1
+    return """/**
+ * @file dht_anomaly_weights.h
+ * @brief Dense-layer weights extracted from dht_anomaly_model_tflite
+ * @note Auto-generated by tools/gen_anomaly_kernel.py - do not edit.
+ *       Regenerated on every build when TINYML_FAST_KERNEL is enabled.
+ *
+ * Layer 1: FULLY_CONNECTED %(i)d -> %(h)d, fused ReLU
+ * Layer 2: FULLY_CONNECTED %(h)d -> 1, followed by LOGISTIC
+ */
+
+#ifndef DHT_ANOMALY_WEIGHTS_H
+#define DHT_ANOMALY_WEIGHTS_H
+
+namespace dht_anomaly_weights {
+
+constexpr int kInputs = %(i)d;   ///< Model inputs (temperature, humidity)
+constexpr int kHidden = %(h)d;   ///< Hidden layer width
+
+/** @brief Layer 1 weights, row-major [kHidden][kInputs] */
+alignas(16) constexpr float kW1[kHidden * kInputs] = {
+    %(w1)s
+};
+
+/** @brief Layer 1 bias [kHidden] */
+alignas(16) constexpr float kB1[kHidden] = {
+    %(b1)s
+};
+
+/** @brief Layer 2 weights [kHidden] */
+alignas(16) constexpr float kW2[kHidden] = {
+    %(w2)s
+};
+
+/** @brief Layer 2 bias */
+constexpr float kB2 = %(b2)s;
+
+} // namespace dht_anomaly_weights
+
+#endif // DHT_ANOMALY_WEIGHTS_H
+""" % {
+        "i": inputs,
+        "h": hidden,
+        "w1": fmt_floats(w1),
+        "b1": fmt_floats(b1),
+        "w2": fmt_floats(w2),
+        "b2": "%.9ef" % b2[0],
+    }
+
+
+def generate(project_dir):
+    src = os.path.join(project_dir, "src", "ml", "dht_anomaly_model.h")
+    dst = os.path.join(project_dir, "src", "ml", "dht_anomaly_weights.h")
+    text = render_header(extract_layers(load_model_bytes(src)))
+    old = None
+    if os.path.exists(dst):
+        with open(dst, "r", encoding="utf-8") as fh:
+            old = fh.read()
+    if old != text:  # only touch the file when weights changed (keeps builds incremental)
+        with open(dst, "w", encoding="utf-8") as fh:
+            fh.write(text)
+        print("[gen_anomaly_kernel] wrote %s" % dst)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    if "TINYML_FAST_KERNEL=1" in str(env.GetProjectOption("build_flags", "")):
+        generate(env.subst("$PROJECT_DIR"))
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+        sys.exit(0)
@@ -0,0 +1,112 @@
+"""
+memory_map.py - Link-time RAM/flash summary of the firmware
+
+Reads the section table (size -A) and symbol table (nm -S) of firmware.elf
+and prints:
+    - DRAM (.dram0.data + .dram0.bss + .noinit), IRAM and flash totals
+    - The largest statically allocated RAM symbols
+
+With -D STATIC_ALLOCATION=1 every task stack, TCB and semaphore the
+firmware owns is in .bss, so the DRAM total is the worst case for them;
+the remaining heap only serves WiFi, WebServer and library buffers.
+
+Usage:
+    python tools/memory_map.py .pio/build/combined/firmware.elf [--tools-prefix xtensa-esp32s3-elf-]
+    extra_scripts = post:tools/memory_map.py   (PlatformIO, runs after linking)
+"""
+
+import os
+import subprocess
+import sys
+
+TOP_SYMBOLS = 15
+
+# Output sections → region (ESP32-S3 linker script names)
+REGIONS = {
+    ".dram0.data": "DRAM",
+    ".dram0.bss": "DRAM",
+    ".noinit": "DRAM",
+    ".iram0.vectors": "IRAM",
+    ".iram0.text": "IRAM",
+    ".iram0.data": "IRAM",
+    ".iram0.bss": "IRAM",
+    ".rtc.text": "RTC",
+    ".rtc.data": "RTC",
+    ".rtc.bss": "RTC",
+    ".flash.appdesc": "Flash",
+    ".flash.rodata": "Flash",
+    ".flash.text": "Flash",
+}
+
+
+def run(tool, args, env=None):
+    return subprocess.run([tool] + args, check=True, capture_output=True, text=True, env=env).stdout
+
+
+def section_sizes(size_tool, elf, env=None):
+    """Return {section: bytes} from `size -A`."""
+    sections = {}
+    for line in run(size_tool, ["-A", elf], env).splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = int(parts[1])
+    return sections
+
+
+def ram_symbols(nm_tool, elf, env=None):
+    """Return [(bytes, kind, name)] for data/bss symbols, largest first."""
+    symbols = []
+    for line in run(nm_tool, ["-S", "-C", "--size-sort", elf], env).splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in "bBdD":
+            kind = "bss" if parts[2] in "bB" else "data"
+            symbols.append((int(parts[1], 16), kind, parts[3]))
+    symbols.sort(reverse=True)
+    return symbols
+
+
+def report(elf, prefix, env=None):
+    sections = section_sizes(prefix + "size", elf, env)
+    totals = {}
+    for name, size in sections.items():
+        region = REGIONS.get(name)
+        if region:
+            totals[region] = totals.get(region, 0) + size
+
+    print("\n[memory_map] %s" % elf)
+    print("[memory_map] %-6s %9s" % ("Region", "Bytes"))
+    for region in ("DRAM", "IRAM", "RTC", "Flash"):
+        print("[memory_map] %-6s %9d" % (region, totals.get(region, 0)))
+    print("[memory_map]   .dram0.data %d, .dram0.bss %d" % (
+        sections.get(".dram0.data", 0), sections.get(".dram0.bss", 0)))
+
+    print("[memory_map] Largest static RAM symbols:")
+    for size, kind, name in ram_symbols(prefix + "nm", elf, env)[:TOP_SYMBOLS]:
+        print("[memory_map] %8d  %-4s  %s" % (size, kind, name))
+
+
+def tools_prefix(size_tool):
+    """'xtensa-esp32s3-elf-size' → 'xtensa-esp32s3-elf-'"""
+    return size_tool[: -len("size")] if size_tool.endswith("size") else ""
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+
+    def _after_link(source, target, env):
+        try:
+            report(str(target[0]), tools_prefix(env.subst("$SIZETOOL")), env["ENV"])
+        except (OSError, subprocess.CalledProcessError) as exc:
+            print("[memory_map] skipped (%s)" % exc)
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _after_link)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        if len(sys.argv) < 2:
+            print(__doc__)
+            sys.exit(1)
+        prefix = "xtensa-esp32s3-elf-"
+        if "--tools-prefix" in sys.argv:
+            prefix = sys.argv[sys.argv.index("--tools-prefix") + 1]
+        report(os.path.abspath(sys.argv[1]), prefix)
+        sys.exit(0)
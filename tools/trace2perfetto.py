@@ -0,0 +1,202 @@
+"""
+trace2perfetto.py - Convert a GET /trace dump to Chrome trace / Perfetto JSON
+
+Reads the binary dump written by src/tasks/trace_recorder.cpp and writes a
+Chrome trace event file that ui.perfetto.dev and chrome://tracing open:
+    - "Cores" process: one row per core with the running task
+      (tick resolution, from SWITCH events)
+    - "Tasks" process: one row per task with job runs, I2C transactions
+      and HTTP handlers as slices, semaphore give/take as instants joined
+      by flow arrows
+
+Timestamps: every record carries the cycle counter of the core that
+recorded it. Per-core SYNC events (esp_timer µs) anchor the counters, so
+32-bit wrap (~18 s at 240 MHz) and the offset between the cores cancel
+out. The counter rate follows the CPU frequency, which power management
+changes at runtime, so events are interpolated between the two SYNC
+anchors around them rather than scaled by the header MHz.
+
+Usage:
+    curl -o trace.bin http://192.168.4.1/trace
+    python tools/trace2perfetto.py trace.bin trace.json
+"""
+
+import json
+import struct
+import sys
+
+HEADER = struct.Struct("<4sHHIIIHH")
+EVENT = struct.Struct("<IBBBBI")
+NAME_LEN = 16
+
+SYNC, SWITCH, GIVE, TAKE, RUN_BEGIN, RUN_END, I2C_BEGIN, I2C_END, HTTP_BEGIN, HTTP_END = range(10)
+NO_LABEL = 0xFF
+
+SLICES = {
+    RUN_BEGIN: ("run", True), RUN_END: ("run", False),
+    I2C_BEGIN: ("i2c", True), I2C_END: ("i2c", False),
+    HTTP_BEGIN: ("http", True), HTTP_END: ("http", False),
+}
+
+PID_CORES = 0
+PID_TASKS = 1
+
+
+def cstr(raw):
+    return raw.split(b"\0", 1)[0].decode("utf-8", "replace")
+
+
+def parse(data):
+    magic, version, event_size, mhz, count, dropped, n_labels, n_tasks = HEADER.unpack_from(data, 0)
+    if magic != b"ETRC" or version != 1 or event_size != EVENT.size:
+        raise ValueError("not a version 1 trace dump")
+    off = HEADER.size
+
+    labels = []
+    for _ in range(n_labels):
+        labels.append(cstr(data[off:off + NAME_LEN]))
+        off += NAME_LEN
+
+    tasks = {}
+    for _ in range(n_tasks):
+        handle, = struct.unpack_from("<I", data, off)
+        tasks[handle] = cstr(data[off + 4:off + 4 + NAME_LEN])
+        off += 4 + NAME_LEN
+
+    events = [EVENT.unpack_from(data, off + i * EVENT.size) for i in range(count)]
+    return mhz, dropped, labels, tasks, events
+
+
+def timestamps(events, mhz):
+    """Return µs per event by interpolating between the per-core SYNC anchors.
+
+    The cycle counter runs at the current CPU frequency, which power
+    management changes at runtime, so each interval between two SYNC
+    events of a core gets its own cycles-per-µs rate. The header MHz is
+    only used when a core has a single anchor.
+    """
+    syncs = {}                      # core -> [(event index, cycles, unwrapped µs)]
+    last_us = {}
+    for i, (cycles, etype, core, _, _, arg) in enumerate(events):
+        if etype != SYNC:
+            continue
+        prev = last_us.get(core)
+        us = arg if prev is None else prev + ((arg - prev) & 0xFFFFFFFF)
+        last_us[core] = us
+        syncs.setdefault(core, []).append((i, cycles, us))
+
+    def rate(a, b):
+        cycles = (b[1] - a[1]) & 0xFFFFFFFF
+        us = b[2] - a[2]
+        return cycles / us if cycles > 0 and us > 0 else float(mhz)
+
+    # Per core: the anchor interval each event falls into, in event order
+    out = [None] * len(events)
+    for core, anchors in syncs.items():
+        rates = [rate(a, b) for a, b in zip(anchors, anchors[1:])] or [float(mhz)]
+        k = 0                       # Current interval: anchors[k] .. anchors[k + 1]
+        for i, (cycles, etype, ev_core, _, _, _) in enumerate(events):
+            if ev_core != core:
+                continue
+            while k + 1 < len(anchors) and anchors[k + 1][0] <= i:
+                k += 1
+            _, base_cycles, base_us = anchors[k]
+            if i < anchors[0][0]:
+                # Before the first SYNC: extrapolate backwards
+                out[i] = base_us - ((base_cycles - cycles) & 0xFFFFFFFF) / rates[0]
+                continue
+            r = rates[min(k, len(rates) - 1)]
+            ts = base_us + ((cycles - base_cycles) & 0xFFFFFFFF) / r
+            if k + 1 < len(anchors):
+                ts = min(ts, anchors[k + 1][2])   # Rate changed inside the interval
+            out[i] = ts
+    return [float(t) if t is not None else None for t in out]   # None: no SYNC for this core
+
+
+def convert(data):
+    mhz, dropped, labels, tasks, events = parse(data)
+    times = timestamps(events, mhz)
+
+    def task_name(handle):
+        return tasks.get(handle, "0x%08x" % handle)
+
+    def label_name(label):
+        return labels[label] if label < len(labels) else "?"
+
+    out = [
+        {"ph": "M", "pid": PID_CORES, "name": "process_name", "args": {"name": "Cores"}},
+        {"ph": "M", "pid": PID_TASKS, "name": "process_name", "args": {"name": "Tasks"}},
+    ]
+    seen_cores, seen_tasks = set(), set()
+    running = {}                    # core -> (task handle, start µs)
+    open_slices = {}                # (handle, kind) -> depth
+    flows = {}                      # label -> pending flow ids
+    flow_id = 0
+
+    for (cycles, etype, core, label, _, arg), ts in zip(events, times):
+        if ts is None:
+            continue
+        if core not in seen_cores:
+            seen_cores.add(core)
+            out.append({"ph": "M", "pid": PID_CORES, "tid": core, "name": "thread_name",
+                        "args": {"name": "Core %d" % core}})
+        if etype != SYNC and arg not in seen_tasks:
+            seen_tasks.add(arg)
+            out.append({"ph": "M", "pid": PID_TASKS, "tid": arg, "name": "thread_name",
+                        "args": {"name": task_name(arg)}})
+
+        if etype == SWITCH:
+            if core in running:
+                handle, start = running[core]
+                out.append({"ph": "X", "pid": PID_CORES, "tid": core, "ts": start,
+                            "dur": max(ts - start, 0.0), "name": task_name(handle), "cat": "sched"})
+            running[core] = (arg, ts)
+
+        elif etype in SLICES:
+            kind, begin = SLICES[etype]
+            key = (arg, kind)
+            if begin:
+                open_slices[key] = open_slices.get(key, 0) + 1
+                name = label_name(label) if kind == "run" else "%s %s" % (kind.upper(), label_name(label))
+                out.append({"ph": "B", "pid": PID_TASKS, "tid": arg, "ts": ts, "name": name, "cat": kind})
+            elif open_slices.get(key, 0) > 0:   # Skip ends whose begin was overwritten
+                open_slices[key] -= 1
+                out.append({"ph": "E", "pid": PID_TASKS, "tid": arg, "ts": ts, "cat": kind})
+
+        elif etype in (GIVE, TAKE):
+            name = "%s %s" % ("give" if etype == GIVE else "take", label_name(label))
+            out.append({"ph": "i", "s": "t", "pid": PID_TASKS, "tid": arg, "ts": ts, "name": name, "cat": "sync"})
+            pending = flows.setdefault(label, [])
+            if etype == GIVE:
+                flow_id += 1
+                pending.append(flow_id)
+                out.append({"ph": "s", "id": flow_id, "pid": PID_TASKS, "tid": arg, "ts": ts,
+                            "name": label_name(label), "cat": "sync"})
+            elif pending:
+                # Binary semaphore: one take consumes every pending give
+                for fid in pending:
+                    out.append({"ph": "f", "bp": "e", "id": fid, "pid": PID_TASKS, "tid": arg, "ts": ts,
+                                "name": label_name(label), "cat": "sync"})
+                pending.clear()
+
+    return {"traceEvents": out, "displayTimeUnit": "ms",
+            "metadata": {"cpu_mhz": mhz, "events": len(events), "dropped": dropped}}
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    trace = convert(data)
+    dst = argv[2] if len(argv) > 2 else argv[1].rsplit(".", 1)[0] + ".json"
+    with open(dst, "w") as f:
+        json.dump(trace, f)
+    meta = trace["metadata"]
+    print("[trace2perfetto] %d events (%d dropped) -> %s" % (meta["events"], meta["dropped"], dst))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))